@@ -0,0 +1,263 @@
+/*********************************************************************
+Frame timing benchmark for the SSD1306 driver on a 128x64 I2C display
+
+Times display() for a full frame, a small text update and a cleared and
+redrawn screen, at 100kHz and at SSD1306_I2C_SPEED, and prints the time
+per frame next to the driver's own bus statistics. Rectangle fills are
+timed in the buffer alone, in pixels per microsecond, and filled shapes
+against the generic Adafruit_GFX versions for a range of sizes. A frame
+is drawn directly after clearDisplay() and through a display list. Results
+go to the serial port.
+*********************************************************************/
+
+#include "Adafruit_GFX.h"
+#include "Adafruit_SSD1306.h"
+#include "SSD1306_DisplayList.h"
+
+SYSTEM_MODE(SEMI_AUTOMATIC);
+
+#define OLED_RESET D4
+Adafruit_SSD1306 display(OLED_RESET);
+SSD1306DisplayList<Adafruit_SSD1306> list(display);
+
+const int RUNS = 20;
+
+void setup()   {
+  Serial.begin(9600);
+  waitFor(Serial.isConnected, 15000);
+
+  display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display.enableStats();
+}
+
+void loop() {
+  setBusSpeed(CLOCK_SPEED_100KHZ);
+  runBenchmarks("100kHz");
+  setBusSpeed(SSD1306_I2C_SPEED);
+  runBenchmarks("fast mode");
+  fillBenchmarks();
+  shapeBenchmarks();
+  crtpBenchmarks();
+  listBenchmarks();
+  display.printStats(Serial);
+  Serial.println();
+  delay(5000);
+}
+
+void setBusSpeed(uint32_t speed) {
+  Wire.end();
+  Wire.setSpeed(speed);
+  Wire.begin();
+}
+
+void runBenchmarks(const char *bus) {
+  uint32_t start, elapsed;
+
+  // whole buffer every frame
+  display.setFlushMode(SSD1306_FLUSH_DIRTY);
+  display.resetStats();
+  start = micros();
+  for (int i=0; i<RUNS; i++) {
+    display.invalidate();
+    display.display();
+  }
+  elapsed = micros() - start;
+  report(bus, "full frame", elapsed);
+
+  // one number redrawn in place
+  display.resetStats();
+  start = micros();
+  for (int i=0; i<RUNS; i++) {
+    display.fillRect(36, 32, 54, 8, BLACK);
+    display.setCursor(36, 32);
+    display.setTextColor(WHITE);
+    display.printf("Table #%i", i % 5);
+    display.display();
+  }
+  elapsed = micros() - start;
+  report(bus, "text update", elapsed);
+
+  // clear and redraw everything, as the game screens do
+  display.setFlushMode(SSD1306_FLUSH_DIFF);
+  display.display();
+  display.resetStats();
+  start = micros();
+  for (int i=0; i<RUNS; i++) {
+    display.clearDisplay();
+    display.setCursor(11, 0);
+    display.printf("TURN RIGHT KNOB TO\n");
+    display.setCursor(12, 13);
+    display.printf("SELECT YOUR TABLE.\n");
+    display.setCursor(36, 32);
+    display.printf("Table #%i\n", i % 5);
+    display.setCursor(1, 52);
+    display.printf("PUSH BUTTON TO BEGIN.\n");
+    display.display();
+  }
+  elapsed = micros() - start;
+  report(bus, "redraw (diff)", elapsed);
+}
+
+// drawing only, nothing is sent - the buffer is cleared and redrawn afterwards
+void fillBenchmarks() {
+  fillRate("full screen", 0, 0, 128, 64);
+  fillRate("aligned 64x16", 32, 16, 64, 16);
+  fillRate("unaligned 54x8", 36, 29, 54, 8);
+  fillRate("small 10x5", 3, 3, 10, 5);
+  display.clearDisplay();
+}
+
+void fillRate(const char *name, int16_t x, int16_t y, int16_t w, int16_t h) {
+  const int FILLS = 1000;
+  uint32_t start = micros();
+  for (int i=0; i<FILLS; i++) {
+    display.fillRect(x, y, w, h, (i & 1) ? WHITE : BLACK);
+  }
+  uint32_t elapsed = micros() - start;
+  Serial.printf("fill      %-14s %7.2f px/us\n", name, (float)w * h * FILLS / elapsed);
+}
+
+// driver span fills against the Adafruit_GFX line-based versions, drawing only
+void shapeBenchmarks() {
+  const int SHAPES = 200;
+  const int16_t radii[] = {2, 4, 8, 16, 31};
+  uint32_t start, generic, spans;
+
+  for (unsigned int i=0; i<sizeof(radii)/sizeof(radii[0]); i++) {
+    int16_t r = radii[i];
+    start = micros();
+    for (int j=0; j<SHAPES; j++) {
+      display.Adafruit_GFX::fillCircle(64, 32, r, (j & 1) ? WHITE : BLACK);
+    }
+    generic = micros() - start;
+    start = micros();
+    for (int j=0; j<SHAPES; j++) {
+      display.fillCircle(64, 32, r, (j & 1) ? WHITE : BLACK);
+    }
+    spans = micros() - start;
+    Serial.printf("circle    r=%-12i %7.2f us generic, %7.2f us spans\n", r, (float)generic / SHAPES, (float)spans / SHAPES);
+  }
+
+  start = micros();
+  for (int j=0; j<SHAPES; j++) {
+    display.Adafruit_GFX::fillRoundRect(10, 10, 100, 40, 8, (j & 1) ? WHITE : BLACK);
+  }
+  generic = micros() - start;
+  start = micros();
+  for (int j=0; j<SHAPES; j++) {
+    display.fillRoundRect(10, 10, 100, 40, 8, (j & 1) ? WHITE : BLACK);
+  }
+  spans = micros() - start;
+  Serial.printf("roundrect 100x40 r=8     %7.2f us generic, %7.2f us spans\n", (float)generic / SHAPES, (float)spans / SHAPES);
+
+  start = micros();
+  for (int j=0; j<SHAPES; j++) {
+    display.Adafruit_GFX::fillTriangle(5, 60, 64, 2, 122, 50, (j & 1) ? WHITE : BLACK);
+  }
+  generic = micros() - start;
+  start = micros();
+  for (int j=0; j<SHAPES; j++) {
+    display.fillTriangle(5, 60, 64, 2, 122, 50, (j & 1) ? WHITE : BLACK);
+  }
+  spans = micros() - start;
+  Serial.printf("triangle  full screen    %7.2f us generic, %7.2f us spans\n", (float)generic / SHAPES, (float)spans / SHAPES);
+  display.clearDisplay();
+}
+
+// the shared algorithms through virtual drawPixel() (Adafruit_GFX::) against
+// GFX<> with the driver's primitives inlined, in CPU cycles per shape. Text at
+// rotation 1, as rotation 0 has its own glyph path
+void crtpBenchmarks() {
+  const int SHAPES = 200;
+  static uint8_t bitmap[32 * 32 / 8];
+  uint32_t start, virtualTicks, inlineTicks;
+
+  for (unsigned int i=0; i<sizeof(bitmap); i++) {
+    bitmap[i] = i * 37;
+  }
+  for (uint8_t rotation=0; rotation<2; rotation++) {
+    display.setRotation(rotation);
+
+    start = System.ticks();
+    for (int j=0; j<SHAPES; j++) {
+      display.Adafruit_GFX::drawCircle(32, 32, 30, (j & 1) ? WHITE : BLACK);
+    }
+    virtualTicks = System.ticks() - start;
+    start = System.ticks();
+    for (int j=0; j<SHAPES; j++) {
+      display.drawCircle(32, 32, 30, (j & 1) ? WHITE : BLACK);
+    }
+    inlineTicks = System.ticks() - start;
+    Serial.printf("rot %u circle r=30        %7lu cycles virtual, %7lu cycles inlined\n", rotation,
+      virtualTicks / SHAPES, inlineTicks / SHAPES);
+
+    start = System.ticks();
+    for (int j=0; j<SHAPES; j++) {
+      display.Adafruit_GFX::drawBitmap(10, 10, bitmap, 32, 32, (j & 1) ? WHITE : BLACK);
+    }
+    virtualTicks = System.ticks() - start;
+    start = System.ticks();
+    for (int j=0; j<SHAPES; j++) {
+      display.drawBitmap(10, 10, bitmap, 32, 32, (j & 1) ? WHITE : BLACK);
+    }
+    inlineTicks = System.ticks() - start;
+    Serial.printf("rot %u bitmap 32x32       %7lu cycles virtual, %7lu cycles inlined\n", rotation,
+      virtualTicks / SHAPES, inlineTicks / SHAPES);
+  }
+
+  start = System.ticks();
+  for (int j=0; j<SHAPES; j++) {
+    display.Adafruit_GFX::drawChar(10, 10, 'A', (j & 1) ? WHITE : BLACK, (j & 1) ? BLACK : WHITE, 1);
+  }
+  virtualTicks = System.ticks() - start;
+  start = System.ticks();
+  for (int j=0; j<SHAPES; j++) {
+    display.drawChar(10, 10, 'A', (j & 1) ? WHITE : BLACK, (j & 1) ? BLACK : WHITE, 1);
+  }
+  inlineTicks = System.ticks() - start;
+  Serial.printf("rot 1 char size 1        %7lu cycles virtual, %7lu cycles inlined\n",
+    virtualTicks / SHAPES, inlineTicks / SHAPES);
+  display.setRotation(0);
+  display.clearDisplay();
+}
+
+// a score line, a moving ball and a progress bar, as one game frame
+template <class Canvas>
+void drawScene(Canvas &canvas, int frame) {
+  const char *score = "SCORE 12";
+  for (int i=0; score[i]; i++) {
+    canvas.drawChar(6 * i, 0, score[i], WHITE, WHITE, 1);
+  }
+  canvas.fillCircle(20 + frame % 80, 30, 4, WHITE);
+  canvas.drawRect(0, 56, 128, 8, WHITE);
+  canvas.fillRect(1, 57, frame % 126, 6, WHITE);
+}
+
+void listBenchmarks() {
+  const int FRAMES = 200;
+  uint32_t start, directTicks, listTicks;
+
+  start = System.ticks();
+  for (int j=0; j<FRAMES; j++) {
+    display.clearDisplay();
+    drawScene(display, j);
+  }
+  directTicks = System.ticks() - start;
+  start = System.ticks();
+  for (int j=0; j<FRAMES; j++) {
+    list.begin();
+    drawScene(list, j);
+    list.end();
+  }
+  listTicks = System.ticks() - start;
+  Serial.printf("scene frame              %7lu cycles direct,  %7lu cycles listed\n",
+    directTicks / FRAMES, listTicks / FRAMES);
+  display.clearDisplay();
+}
+
+// each benchmark starts with resetStats(), so the averages cover its own frames
+void report(const char *bus, const char *name, uint32_t elapsed) {
+  const SSD1306Stats &stats = display.stats();
+  Serial.printf("%-9s %-14s %7.2f ms/frame (%7.2f ms on the bus), %4u bytes in %3u transactions\n",
+    bus, name, elapsed / 1000.0 / RUNS, stats.avgMicros / 1000.0, stats.avgBytes, stats.transactions);
+}
@@ -6,7 +6,19 @@
 
 #define swap(a, b) { int16_t t = a; a = b; b = t; }
 
-class Adafruit_GFX : public Print {
+// clipTest() results
+#define GFX_CLIP_OUTSIDE 0
+#define GFX_CLIP_PARTIAL 1
+#define GFX_CLIP_INSIDE  2
+
+#include "Adafruit_GFXT.h"
+
+// The generic line, circle, bitmap and glyph algorithms are GFX<> drawing
+// through the virtual primitives below, the same code displays inline over
+// their own primitives
+class Adafruit_GFX : public Print, private GFX<Adafruit_GFX> {
+  typedef GFX<Adafruit_GFX> Generic;
+  friend class GFX<Adafruit_GFX>;
 
  public:
 
@@ -24,28 +36,35 @@ class Adafruit_GFX : public Print {
     drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillScreen(uint16_t color),
-    invertDisplay(boolean i);
+    invertDisplay(boolean i),
+    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+      uint16_t bg, uint8_t size),
+    fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+    fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2, uint16_t color),
+    fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+      int16_t radius, uint16_t color),
+    setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  // Drawing is confined to the clip rectangle, in the current rotation.
+  // Shapes wholly outside it are dropped before any pixel is visited;
+  // setRotation() resets it to the whole screen
+  void resetClipRect(void);
+  uint8_t clipTest(int16_t x, int16_t y, int16_t w, int16_t h);
 
   // These exist only with Adafruit_GFX (no subclass overrides)
   void
     drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
+    drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+      int16_t radius, uint16_t color),
+    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, uint16_t color),
     drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       uint16_t color),
-    fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
     fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       int16_t delta, uint16_t color),
     drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
       int16_t x2, int16_t y2, uint16_t color),
-    fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
-      int16_t x2, int16_t y2, uint16_t color),
-    drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
-      int16_t radius, uint16_t color),
-    fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
-      int16_t radius, uint16_t color),
-    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
-      int16_t w, int16_t h, uint16_t color),
-    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-      uint16_t bg, uint8_t size),
     setCursor(int16_t x, int16_t y),
     setTextColor(uint16_t c),
     setTextColor(uint16_t c, uint16_t bg),
@@ -60,6 +79,9 @@ class Adafruit_GFX : public Print {
     width(void);
 
   uint8_t getRotation(void);
+  uint8_t getTextSize(void);
+  uint16_t getTextColor(void);
+  uint16_t getTextBackground(void);
 
  protected:
   const int16_t
@@ -74,6 +96,21 @@ class Adafruit_GFX : public Print {
     rotation;
   boolean
     wrap; // If set, 'wrap' text at right edge of display
+  boolean
+    triangleClipped(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2),
+    roundRectClipped(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r);
+  int16_t
+    clip_x0, clip_y0, // Clip rectangle, top left inclusive,
+    clip_x1, clip_y1; // bottom right exclusive, within _width x _height
+
+ private:
+  // GFX<> primitives, one virtual call each
+  void pixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+  void pixelUnclipped(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+  void hspan(int16_t x, int16_t y, int16_t w, uint16_t color) { drawFastHLine(x, y, w, color); }
+  void vspan(int16_t x, int16_t y, int16_t h, uint16_t color) { drawFastVLine(x, y, h, color); }
+  void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { fillRect(x, y, w, h, color); }
 };
 
 #endif // _ADAFRUIT_GFX_H
@@ -0,0 +1,297 @@
+#ifndef _ADAFRUIT_GFXT_H
+#define _ADAFRUIT_GFXT_H
+
+/*********************************************************************
+The generic Adafruit_GFX algorithms as a CRTP template. GFX<Derived>
+draws through non-virtual primitives of the display class, all of
+them clipped to the clip rectangle except pixelUnclipped()
+
+  void pixel(int16_t x, int16_t y, uint16_t color);
+  void pixelUnclipped(int16_t x, int16_t y, uint16_t color);
+  void hspan(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void vspan(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+so they inline into the inner loops instead of costing a virtual call
+per pixel. A display derives from Adafruit_GFX and privately from
+GFX<itself>, befriending it, and its virtual overrides forward here,
+which keeps code written against Adafruit_GFX working unchanged.
+Adafruit_GFX is GFX<Adafruit_GFX> over its virtual primitives, so the
+generic versions and the inlined ones are the same code.
+
+Each shape tests its bounding box against the clip rectangle once:
+outside, it is dropped; inside, its points skip the bounds check.
+The pixels drawn are exactly those of the Adafruit_GFX versions.
+*********************************************************************/
+
+// swap() and the GFX_CLIP_ results come from Adafruit_GFX.h, which
+// includes this file before declaring Adafruit_GFX
+#ifndef _ADAFRUIT_GFX_H
+#error "include Adafruit_GFX.h instead of Adafruit_GFXT.h"
+#endif
+
+#include "glcdfont.h"
+
+template <class Derived>
+class GFX {
+ public:
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    switch (d().clipTest((x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1, abs(x1 - x0) + 1, abs(y1 - y0) + 1)) {
+    case GFX_CLIP_OUTSIDE:
+      return;
+    case GFX_CLIP_INSIDE:
+      line<true>(x0, y0, x1, y1, color);
+      return;
+    default:
+      line<false>(x0, y0, x1, y1, color);
+    }
+  }
+
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    switch (d().clipTest(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1)) {
+    case GFX_CLIP_OUTSIDE:
+      return;
+    case GFX_CLIP_INSIDE:
+      circle<true>(x0, y0, r, color);
+      return;
+    default:
+      circle<false>(x0, y0, r, color);
+    }
+  }
+
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+    switch (d().clipTest(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1)) {
+    case GFX_CLIP_OUTSIDE:
+      return;
+    case GFX_CLIP_INSIDE:
+      corners<true>(x0, y0, r, cornername, color);
+      return;
+    default:
+      corners<false>(x0, y0, r, cornername, color);
+    }
+  }
+
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (d().clipTest(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1) == GFX_CLIP_OUTSIDE)
+      return;
+    d().vspan(x0, y0-r, 2*r+1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+  }
+
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, int16_t delta, uint16_t color) {
+    int16_t f     = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x     = 0;
+    int16_t y     = r;
+
+    while (x<y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f     += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f     += ddF_x;
+
+      if (cornername & 0x1) {
+        d().vspan(x0+x, y0-y, 2*y+1+delta, color);
+        d().vspan(x0+y, y0-x, 2*x+1+delta, color);
+      }
+      if (cornername & 0x2) {
+        d().vspan(x0-x, y0-y, 2*y+1+delta, color);
+        d().vspan(x0-y, y0-x, 2*x+1+delta, color);
+      }
+    }
+  }
+
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    if (d().roundRectClipped(x, y, w, h, r))
+      return;
+    d().hspan(x+r  , y    , w-2*r, color); // Top
+    d().hspan(x+r  , y+h-1, w-2*r, color); // Bottom
+    d().vspan(x    , y+r  , h-2*r, color); // Left
+    d().vspan(x+w-1, y+r  , h-2*r, color); // Right
+    // draw four corners
+    drawCircleHelper(x+r    , y+r    , r, 1, color);
+    drawCircleHelper(x+w-r-1, y+r    , r, 2, color);
+    drawCircleHelper(x+w-r-1, y+h-r-1, r, 4, color);
+    drawCircleHelper(x+r    , y+h-r-1, r, 8, color);
+  }
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    switch (d().clipTest(x, y, w, h)) {
+    case GFX_CLIP_OUTSIDE:
+      return;
+    case GFX_CLIP_INSIDE:
+      bitmapRows<true>(x, y, bitmap, w, h, color);
+      return;
+    default:
+      bitmapRows<false>(x, y, bitmap, w, h, color);
+    }
+  }
+
+  // any size and rotation, big sizes as size x size blocks
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    switch (d().clipTest(x, y, 6 * size, 8 * size)) {
+    case GFX_CLIP_OUTSIDE:
+      return;
+    case GFX_CLIP_INSIDE:
+      glyph<true>(x, y, c, color, bg, size);
+      return;
+    default:
+      glyph<false>(x, y, c, color, bg, size);
+    }
+  }
+
+ private:
+  Derived &d(void) { return static_cast<Derived &>(*this); }
+
+  // one point, without the bounds check when the whole shape is inside the clip
+  template <bool INSIDE>
+  void plot(int16_t x, int16_t y, uint16_t color) {
+    if (INSIDE)
+      d().pixelUnclipped(x, y, color);
+    else
+      d().pixel(x, y, color);
+  }
+
+  // Bresenham's algorithm, as Adafruit_GFX::drawLine
+  template <bool INSIDE>
+  void line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      swap(x0, y0);
+      swap(x1, y1);
+    }
+    if (x0 > x1) {
+      swap(x0, x1);
+      swap(y0, y1);
+    }
+
+    int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0<=x1; x0++) {
+      if (steep) {
+        plot<INSIDE>(y0, x0, color);
+      } else {
+        plot<INSIDE>(x0, y0, color);
+      }
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
+  template <bool INSIDE>
+  void circle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    plot<INSIDE>(x0  , y0+r, color);
+    plot<INSIDE>(x0  , y0-r, color);
+    plot<INSIDE>(x0+r, y0  , color);
+    plot<INSIDE>(x0-r, y0  , color);
+
+    while (x<y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+
+      plot<INSIDE>(x0 + x, y0 + y, color);
+      plot<INSIDE>(x0 - x, y0 + y, color);
+      plot<INSIDE>(x0 + x, y0 - y, color);
+      plot<INSIDE>(x0 - x, y0 - y, color);
+      plot<INSIDE>(x0 + y, y0 + x, color);
+      plot<INSIDE>(x0 - y, y0 + x, color);
+      plot<INSIDE>(x0 + y, y0 - x, color);
+      plot<INSIDE>(x0 - y, y0 - x, color);
+    }
+  }
+
+  template <bool INSIDE>
+  void corners(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+    int16_t f     = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x     = 0;
+    int16_t y     = r;
+
+    while (x<y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f     += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f     += ddF_x;
+      if (cornername & 0x4) {
+        plot<INSIDE>(x0 + x, y0 + y, color);
+        plot<INSIDE>(x0 + y, y0 + x, color);
+      }
+      if (cornername & 0x2) {
+        plot<INSIDE>(x0 + x, y0 - y, color);
+        plot<INSIDE>(x0 + y, y0 - x, color);
+      }
+      if (cornername & 0x8) {
+        plot<INSIDE>(x0 - y, y0 + x, color);
+        plot<INSIDE>(x0 - x, y0 + y, color);
+      }
+      if (cornername & 0x1) {
+        plot<INSIDE>(x0 - y, y0 - x, color);
+        plot<INSIDE>(x0 - x, y0 - y, color);
+      }
+    }
+  }
+
+  // row-major bitmap, MSB first, as Adafruit_GFX::drawBitmap
+  template <bool INSIDE>
+  void bitmapRows(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+
+    for (int16_t j=0; j<h; j++) {
+      for (int16_t i=0; i<w; i++) {
+        if (bitmap[j * byteWidth + i / 8] & (128 >> (i & 7))) {
+          plot<INSIDE>(x+i, y+j, color);
+        }
+      }
+    }
+  }
+
+  template <bool INSIDE>
+  void glyph(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    for (int8_t i=0; i<6; i++) {
+      uint8_t line = (i == 5) ? 0 : glcdfont[(c*5)+i];
+      for (int8_t j=0; j<8; j++, line >>= 1) {
+        uint16_t ink;
+        if (line & 0x1)
+          ink = color;
+        else if (bg != color)
+          ink = bg;
+        else
+          continue;
+        if (size == 1) {
+          plot<INSIDE>(x+i, y+j, ink);
+        } else {
+          d().rect(x+i*size, y+j*size, size, size, ink);
+        }
+      }
+    }
+  }
+};
+
+#endif // _ADAFRUIT_GFXT_H
@@ -16,9 +16,12 @@ BSD license, check license.txt for more information
 All text above, and the splash screen must be included in any redistribution
 *********************************************************************/
 
+#ifndef _ADAFRUIT_SSD1306_H
+#define _ADAFRUIT_SSD1306_H
 
 #include "application.h"
 #include "Adafruit_GFX.h"
+#include "SSD1306_Text.h"
 
 
 #define BLACK 0
@@ -32,8 +35,10 @@ All text above, and the splash screen must be included in any redistribution
     SSD1306 Displays
     -----------------------------------------------------------------------
     The driver is used in multiple displays (128x64, 128x32, etc.).
-    Select the appropriate display below to create an appropriately
-    sized framebuffer, etc.
+    Select the appropriate display below for the Adafruit_SSD1306
+    type. Each object has its own framebuffer, so panels of other sizes
+    can be declared alongside it as Adafruit_SSD1306T<width, height>.
+    Panels narrower than 128 are drawn on the middle controller columns.
 
     SSD1306_128_64  128x64 pixel display
 
@@ -97,6 +102,30 @@ All text above, and the splash screen must be included in any redistribution
 #define SSD1306_EXTERNALVCC 0x1
 #define SSD1306_SWITCHCAPVCC 0x2
 
+// display() flush modes
+#define SSD1306_FLUSH_DIRTY 0   // send the column ranges touched by drawing (default)
+#define SSD1306_FLUSH_DIFF  1   // compare against the last frame sent and send only changed bytes
+#define SSD1306_SPAN_MERGE  12  // unchanged bytes worth sending to save one window's addressing commands
+
+// I2C bus speed set by begin(), the SSD1306 is specified up to 400kHz
+#ifndef SSD1306_I2C_SPEED
+  #define SSD1306_I2C_SPEED CLOCK_SPEED_400KHZ
+#endif
+
+// hardware SPI clock, taken with SPI.beginTransaction() each time the panel is selected
+#ifndef SSD1306_SPI_CLOCK
+  #define SSD1306_SPI_CLOCK (9*MHZ)
+#endif
+
+// default Wire transmission size, see setWireBuffer()
+#ifndef SSD1306_WIRE_BUFFER
+  #ifdef I2C_BUFFER_LENGTH
+    #define SSD1306_WIRE_BUFFER I2C_BUFFER_LENGTH
+  #else
+    #define SSD1306_WIRE_BUFFER 32
+  #endif
+#endif
+
 // Scrolling #defines
 #define SSD1306_ACTIVATE_SCROLL 0x2F
 #define SSD1306_DEACTIVATE_SCROLL 0x2E
@@ -106,19 +135,81 @@ All text above, and the splash screen must be included in any redistribution
 #define SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL 0x29
 #define SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL 0x2A
 
-class Adafruit_SSD1306 : public Adafruit_GFX {
+// bus counters for display(), see enableStats(). Commands sent between frames
+// (dim(), invertDisplay(), scrolling) are not counted
+#define SSD1306_STATS_FRAMES 16   // frames in the rolling min/avg/max
+
+struct SSD1306Stats {
+  // last frame
+  uint16_t transactions;   // I2C transmissions or SPI chip selects
+  uint16_t bytes;          // everything after the I2C address, control bytes included
+  uint16_t commandBytes;
+  uint16_t dataBytes;
+  uint8_t spans;           // address windows sent
+  uint32_t micros;         // time in display() or on the flush thread
+  // since begin() or resetStats()
+  uint32_t frames;
+  uint32_t totalBytes;
+  // over the last SSD1306_STATS_FRAMES frames
+  uint32_t minMicros, avgMicros, maxMicros;
+  uint16_t minBytes, avgBytes, maxBytes;
+};
+
+template <int16_t W, int16_t H>
+class Adafruit_SSD1306T : public Adafruit_GFX, private GFX<Adafruit_SSD1306T<W, H> > {
+  static_assert(W <= 128 && H <= 64 && H % 8 == 0, "SSD1306 panels are at most 128x64 in whole pages");
+
+  // the shared algorithms, inlined over pixel(), hspan(), vspan() and rect().
+  // Qualified, as inside the class GFX names Adafruit_GFX's private base
+  typedef ::GFX<Adafruit_SSD1306T<W, H> > Generic;
+  friend class ::GFX<Adafruit_SSD1306T<W, H> >;
+
  public:
-  Adafruit_SSD1306(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS);
-  Adafruit_SSD1306(int8_t DC, int8_t RST, int8_t CS);
-  Adafruit_SSD1306(int8_t RST);
+  static const uint8_t PAGES = H / 8;
+  static const uint16_t BUFFER_SIZE = W * H / 8;
+  // the controller has 128 columns, narrower glass is wired to the middle ones
+  static const uint8_t COLUMN_OFFSET = (128 - W) / 2;
+
+  Adafruit_SSD1306T(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS);
+  Adafruit_SSD1306T(int8_t DC, int8_t RST, int8_t CS);
+  Adafruit_SSD1306T(int8_t RST);
 
   void begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = SSD1306_I2C_ADDRESS);
   void ssd1306_command(uint8_t c);
+  void ssd1306_commandList(const uint8_t *c, uint8_t n);
+  void setWireBuffer(uint16_t size);
   void ssd1306_data(uint8_t c);
 
   void clearDisplay(void);
   void invertDisplay(uint8_t i);
   void display();
+  void displayAsync(void);
+  bool displayBusy(void) { return _busy; }
+  void waitDisplay(void);
+  void invalidate(void);  // resend the whole buffer on the next display()
+
+  // static screen content: draw it once, saveLayer() into a BUFFER_SIZE array, then
+  // start each frame with restoreLayer() and draw only what changes
+  void saveLayer(uint8_t *layer) { memcpy(layer, buffer, BUFFER_SIZE); }
+  void restoreLayer(const uint8_t *layer);
+  // whole panel pages (bit n is rows 8n to 8n+7 at rotation 0) in one color,
+  // whatever the rotation or clip, like fillScreen()
+  void fillPages(uint8_t pages, uint16_t color);
+  void setFlushMode(uint8_t mode);
+
+  // transfer counters, bytes include addressing commands and control bytes. The
+  // flush thread writes them, so these wait for a displayAsync() frame to finish
+  uint16_t frameBytes(void) { waitDisplay(); return _stats.bytes; }
+  uint8_t frameSpans(void) { waitDisplay(); return _stats.spans; }
+  uint32_t totalBytes(void) { waitDisplay(); return _stats.totalBytes; }
+
+  // timing and rolling history cost a couple of micros() calls per frame, so
+  // they are off until enabled. The reference from stats() is only stable until
+  // the next displayAsync()
+  void enableStats(bool enable = true) { _statsEnabled = enable; }
+  void resetStats(void);
+  const SSD1306Stats &stats(void) { waitDisplay(); return _stats; }
+  void printStats(Print &out);
 
   void startscrollright(uint8_t start, uint8_t stop);
   void startscrollleft(uint8_t start, uint8_t stop);
@@ -126,6 +217,7 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
   void startscrolldiagright(uint8_t start, uint8_t stop);
   void startscrolldiagleft(uint8_t start, uint8_t stop);
   void stopscroll(void);
+  void setStartLine(uint8_t line);
 
   void dim(bool dim);
 
@@ -133,15 +225,126 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
 
   virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color);
+  virtual void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  virtual void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  virtual void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+  virtual void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+  // every drawing call is clipped to it, except fillScreen(), clearDisplay(),
+  // fillPages() and restoreLayer(), which always cover whole pages
+  virtual void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color);
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, int16_t delta, uint16_t color);
+
+  // text rasterized at compile time, see SSD1306_Text.h. Rotation 0, any y
+  template <size_t N>
+  void blitText(int16_t x, int16_t y, const SSD1306Text<N> &text, uint16_t color = WHITE) {
+    blitColumns(x, y, text.columns, text.WIDTH, color);
+  }
+  // one page-high strip of column bytes, set bits drawn in color, clear bits left alone
+  void blitColumns(int16_t x, int16_t y, const uint8_t *columns, int16_t width, uint16_t color) {
+    blitStrip(x, y, columns, NULL, 0xFF, width, color);
+  }
+
+  // page-format images (w bytes per 8 rows, top row in bit 0, see tools/sprite2ssd1306.py)
+  // at any position. Without a mask set bits are drawn in color and clear bits are
+  // transparent; with a mask, pixels under it are drawn as the image (set WHITE,
+  // clear BLACK) and the rest is left alone
+  void drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color = WHITE);
+  void drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h);
 
  private:
   int8_t _i2caddr, _vccstate, sid, sclk, dc, rst, cs;
   void fastSPIwrite(uint8_t c);
+  void fastSPIwrite(const uint8_t *c, uint16_t n);
+  bool _inFrame, _spiSelected;  // _inFrame: flushFrame() running, counting and holding chip select
+  void spiBegin(uint8_t dcLevel);
+  void spiEnd(void);
 
   boolean hwSPI;
 
+  // the memory buffer for the LCD
+  uint8_t buffer[W * H / 8] __attribute__((aligned(4)));
+  // copy of the last frame sent to the panel, used by SSD1306_FLUSH_DIFF
+  uint8_t shadow[W * H / 8] __attribute__((aligned(4)));
+  // frame frozen by displayAsync() while the flush thread sends it
+  uint8_t front[W * H / 8] __attribute__((aligned(4)));
+  void initState(void);
+
+  // columns changed since the last display(), per page (empty when min > max)
+  uint8_t dirtyMin[PAGES], dirtyMax[PAGES];
+  inline void markDirty(uint8_t page, uint8_t x0, uint8_t x1) {
+    if (x0 < dirtyMin[page]) dirtyMin[page] = x0;
+    if (x1 > dirtyMax[page]) dirtyMax[page] = x1;
+  }
+
+  uint8_t _flushMode;
+  boolean _shadowValid;
+  SSD1306Stats _stats;
+  bool _statsEnabled;
+  uint32_t _historyMicros[SSD1306_STATS_FRAMES];
+  uint16_t _historyBytes[SSD1306_STATS_FRAMES];
+  uint8_t _historyCount, _historyHead;
+  void recordFrame(uint32_t elapsed);
+  uint16_t _wireChunk;
+  void sendCommands(const uint8_t *c, uint8_t n);
+  void sendWindow(const uint8_t *src, uint8_t page, uint8_t x0, uint8_t x1);
+  void sendChanges(const uint8_t *src, uint8_t page, uint8_t x0, uint8_t x1);
+  void flushFrame(const uint8_t *src, uint8_t *rangeMin, uint8_t *rangeMax);
+
+  // background flush for displayAsync()
+  Thread *_flushThread;
+  os_semaphore_t _flushStart, _flushIdle;
+  volatile bool _busy;
+  uint8_t pendingMin[PAGES], pendingMax[PAGES];
+  void flushWorker(void);
+
+  // the clip rectangle in panel coordinates, right and bottom exclusive
+  int16_t _clipLeft, _clipTop, _clipRight, _clipBottom;
+  inline void toPanel(int16_t &x, int16_t &y) __attribute__((always_inline));
+  inline void toPanel(int16_t &x, int16_t &y, int16_t &w, int16_t &h);
+  // rows of a page inside the clip rectangle, as a byte mask
+  inline uint8_t clipRows(int16_t page) {
+    int16_t top = _clipTop - page * 8, bottom = _clipBottom - page * 8;
+    if (top >= 8 || bottom <= 0)
+      return 0;
+    return (0xFF << (top > 0 ? top : 0)) & (0xFF >> (bottom < 8 ? 8 - bottom : 0));
+  }
+
+  // the primitives GFX<> inlines into its loops, rotated and clipped like their
+  // drawPixel(), drawFastHLine(), drawFastVLine() and fillRect() adapters
+  inline void pixel(int16_t x, int16_t y, uint16_t color) __attribute__((always_inline));
+  inline void pixelUnclipped(int16_t x, int16_t y, uint16_t color) __attribute__((always_inline));
+  inline void panelPixel(int16_t x, int16_t y, uint16_t color) __attribute__((always_inline));
+  inline void hspan(int16_t x, int16_t y, int16_t w, uint16_t color);
+  inline void vspan(int16_t x, int16_t y, int16_t h, uint16_t color);
+  inline void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   inline void drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color) __attribute__((always_inline));
   inline void drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color) __attribute__((always_inline));
-
+  void blitStrip(int16_t x, int16_t y, const uint8_t *columns, const uint8_t *mask, uint8_t rows, int16_t width, uint16_t color);
+  void blitPage(uint8_t page, int16_t x, const uint8_t *columns, const uint8_t *mask, uint8_t rows, int16_t width, int8_t shift, uint16_t color);
+  void drawSpriteInternal(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h, uint16_t color);
+  // Cohen-Sutherland region bits: 1 left, 2 right, 4 above, 8 below
+  inline uint8_t outcode(int16_t x, int16_t y) {
+    return (x < _clipLeft) | ((x >= _clipRight) << 1) | ((y < _clipTop) << 2) | ((y >= _clipBottom) << 3);
+  }
+  inline void lineRun(bool steep, int16_t a, int16_t b, int16_t m, uint16_t color);
+  inline void spanBits(uint8_t *pBuf, int16_t x0, int16_t x1, uint8_t mask, uint16_t color);
+  void fillRowSpans(int16_t top, int16_t bottom, int16_t *left, int16_t *right, uint16_t color);
+  void fillRectInternal(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
 };
 
+#include "Adafruit_SSD1306.tpp"
+
+// compiled once in Adafruit_SSD1306.cpp
+extern template class Adafruit_SSD1306T<128, 64>;
+extern template class Adafruit_SSD1306T<128, 32>;
+
+typedef Adafruit_SSD1306T<SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT> Adafruit_SSD1306;
+
+#endif // _ADAFRUIT_SSD1306_H
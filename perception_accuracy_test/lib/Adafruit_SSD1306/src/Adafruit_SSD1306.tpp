@@ -0,0 +1,1505 @@
+// Adafruit_SSD1306T<W, H> member definitions, included by Adafruit_SSD1306.h so
+// any panel size can be instantiated. 128x64 and 128x32 are compiled once in
+// Adafruit_SSD1306.cpp and declared extern template in the header
+
+#include "glcdfont.h"
+
+// 128x64 splash screen, defined in Adafruit_SSD1306.cpp
+extern const uint8_t ssd1306_splash[128 * 64 / 8];
+
+// the most basic function, set a single pixel
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  pixel(x, y, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::pixel(int16_t x, int16_t y, uint16_t color) {
+  toPanel(x, y);
+  if (x < _clipLeft || x >= _clipRight || y < _clipTop || y >= _clipBottom)
+    return;
+  panelPixel(x, y, color);
+}
+
+// for shapes already known to lie inside the clip rectangle
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::pixelUnclipped(int16_t x, int16_t y, uint16_t color) {
+  toPanel(x, y);
+  panelPixel(x, y, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::panelPixel(int16_t x, int16_t y, uint16_t color) {
+  // x is which column
+  uint8_t *pBuf = &buffer[x+ (y/8)*W];
+  uint8_t old = *pBuf;
+  if (color == WHITE) 
+    *pBuf |= (1 << (y&7));  
+  else
+    *pBuf &= ~(1 << (y&7)); 
+  if (*pBuf != old)
+    markDirty(y/8, x, x);
+}
+
+// rotated coordinates to panel coordinates, for a point and for a box
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::toPanel(int16_t &x, int16_t &y) {
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = W - y - 1;
+    y = t;
+    break;
+  case 2:
+    x = W - x - 1;
+    y = H - y - 1;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = H - t - 1;
+    break;
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::toPanel(int16_t &x, int16_t &y, int16_t &w, int16_t &h) {
+  int16_t t;
+  switch(rotation) {
+    case 1:
+      t = x;
+      x = W - y - h;
+      y = t;
+      swap(w, h);
+      break;
+    case 2:
+      x = W - x - w;
+      y = H - y - h;
+      break;
+    case 3:
+      t = y;
+      y = H - x - w;
+      x = t;
+      swap(w, h);
+      break;
+  }
+}
+
+// the base class keeps the rectangle in rotated coordinates for whole-shape
+// tests, the internals clip against the panel coordinates kept here
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  Adafruit_GFX::setClipRect(x, y, w, h);
+  x = clip_x0;
+  y = clip_y0;
+  w = clip_x1 - clip_x0;
+  h = clip_y1 - clip_y0;
+  toPanel(x, y, w, h);
+  _clipLeft = x;
+  _clipTop = y;
+  _clipRight = x + w;
+  _clipBottom = y + h;
+}
+
+// constructor for software SPI - we indicate DataCommand, ChipSelect, Reset 
+template <int16_t W, int16_t H>
+Adafruit_SSD1306T<W, H>::Adafruit_SSD1306T(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS) : Adafruit_GFX(W, H) {
+  cs = CS;
+  rst = RST;
+  dc = DC;
+  sclk = SCLK;
+  sid = SID;
+  hwSPI = false;
+  initState();
+}
+
+// constructor for hardware SPI - we indicate DataCommand, ChipSelect, Reset 
+template <int16_t W, int16_t H>
+Adafruit_SSD1306T<W, H>::Adafruit_SSD1306T(int8_t DC, int8_t RST, int8_t CS) : Adafruit_GFX(W, H) {
+  dc = DC;
+  rst = RST;
+  cs = CS;
+  sclk = sid = -1;   // the bus is chosen by cs, SPI pins belong to the SPI peripheral
+  hwSPI = true;
+  initState();
+}
+
+// initializer for I2C - we only indicate the reset pin!
+template <int16_t W, int16_t H>
+Adafruit_SSD1306T<W, H>::Adafruit_SSD1306T(int8_t reset) :
+Adafruit_GFX(W, H) {
+  sclk = dc = cs = sid = -1;
+  rst = reset;
+  initState();
+}
+
+// state shared by the constructors, the buffer starts with the splash screen
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::initState(void) {
+  if (W == 128)
+    memcpy(buffer, ssd1306_splash, sizeof(buffer));
+  else
+    memset(buffer, 0, sizeof(buffer));
+  _flushMode = SSD1306_FLUSH_DIRTY;
+  _flushThread = NULL;
+  _busy = false;
+  _statsEnabled = false;
+  resetStats();
+  _wireChunk = SSD1306_WIRE_BUFFER - 1;
+  _inFrame = _spiSelected = false;
+  _clipLeft = _clipTop = 0;
+  _clipRight = W;
+  _clipBottom = H;
+  invalidate();
+}
+  
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::begin(uint8_t vccstate, uint8_t i2caddr) {
+  _vccstate = vccstate;
+  _i2caddr = i2caddr;
+
+  // set pin directions
+  if (cs != -1){
+    pinMode(dc, OUTPUT);
+    pinMode(cs, OUTPUT);
+    if (!hwSPI){
+    	// set pins for software-SPI
+    	pinMode(sid, OUTPUT);
+    	pinMode(sclk, OUTPUT);
+    	}
+    if (hwSPI){
+        digitalWrite(cs, HIGH);
+        SPI.setBitOrder(MSBFIRST);
+        SPI.setClockDivider(SPI_CLOCK_DIV8);	// 72MHz / 8 = 9Mhz
+        SPI.setDataMode(0);
+        SPI.begin();	
+    	}
+    }
+  else
+  {
+    // I2C Init - fast mode, set before begin()
+    Wire.setSpeed(SSD1306_I2C_SPEED);
+    Wire.begin();
+  }
+
+  // Setup reset pin direction (used by both SPI and I2C)  
+  pinMode(rst, OUTPUT);
+  digitalWrite(rst, HIGH);
+  // VDD (3.3V) goes high at start, lets just chill for a ms
+  delay(1);
+  // bring reset low
+  digitalWrite(rst, LOW);
+  // wait 10ms
+  delay(10);
+  // bring out of reset
+  digitalWrite(rst, HIGH);
+  // turn on VCC (9V?)
+
+  // Init sequence, sent as one command list
+  uint8_t init[] = {
+    SSD1306_DISPLAYOFF,                    // 0xAE
+    SSD1306_SETDISPLAYCLOCKDIV,            // 0xD5
+    0x80,                                  // the suggested ratio 0x80
+    SSD1306_SETMULTIPLEX,                  // 0xA8
+    H - 1,                 // 0x3F for 128x64, 0x1F for 128x32
+    SSD1306_SETDISPLAYOFFSET,              // 0xD3
+    0x0,                                   // no offset
+    SSD1306_SETSTARTLINE | 0x0,            // line #0
+    SSD1306_CHARGEPUMP,                    // 0x8D
+    (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14),
+    SSD1306_MEMORYMODE,                    // 0x20
+    0x00,                                  // 0x0 act like ks0108
+    SSD1306_SEGREMAP | 0x1,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS,                    // 0xDA
+    // sequential COM pins only on 128x32 and 96x16 glass, alternative on 128x64, 64x48, 64x32
+    (uint8_t)(((W == 128 && H == 32) || (W == 96 && H == 16)) ? 0x02 : 0x12),
+    SSD1306_SETCONTRAST,                   // 0x81
+    (uint8_t)((H == 32) ? 0x8F : (vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF),
+    SSD1306_SETPRECHARGE,                  // 0xd9
+    (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1),
+    SSD1306_SETVCOMDETECT,                 // 0xDB
+    0x40,
+    SSD1306_DISPLAYALLON_RESUME,           // 0xA4
+    SSD1306_NORMALDISPLAY,                 // 0xA6
+    SSD1306_DISPLAYON                      //--turn on oled panel
+  };
+  ssd1306_commandList(init, sizeof(init));
+}
+
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::invertDisplay(uint8_t i) {
+  if (i) {
+    ssd1306_command(SSD1306_INVERTDISPLAY);
+  } else {
+    ssd1306_command(SSD1306_NORMALDISPLAY);
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::ssd1306_command(uint8_t c) { 
+  waitDisplay();
+  if (cs != -1)
+  {
+    // SPI
+    spiBegin(LOW);
+    fastSPIwrite(c);
+    spiEnd();
+  }
+  else
+  {
+    // I2C
+    uint8_t control = 0x00;   // Co = 0, D/C = 0
+    WITH_LOCK(Wire) {
+      Wire.beginTransmission(_i2caddr);
+      Wire.write(control);
+      Wire.write(c);
+      Wire.endTransmission();
+    }
+  }
+}
+
+// send a sequence of commands in one transaction (several if it exceeds the Wire buffer)
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::ssd1306_commandList(const uint8_t *c, uint8_t n) {
+  waitDisplay();
+  sendCommands(c, n);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::sendCommands(const uint8_t *c, uint8_t n) {
+  if (cs != -1)
+  {
+    // SPI
+    spiBegin(LOW);
+    fastSPIwrite(c, n);
+    spiEnd();
+    if (_inFrame) {
+      _stats.bytes += n;
+      _stats.commandBytes += n;
+    }
+  }
+  else
+  {
+    // I2C
+    uint8_t control = 0x00;   // Co = 0, D/C = 0 - every following byte is a command
+    for (uint8_t i=0; i<n; ) {
+      uint16_t x;
+      WITH_LOCK(Wire) {
+        Wire.beginTransmission(_i2caddr);
+        Wire.write(control);
+        for (x=0; x<_wireChunk && i<n; x++) {
+          Wire.write(c[i]);
+          i++;
+        }
+        Wire.endTransmission();
+      }
+      if (_inFrame) {  // dim(), invertDisplay() etc. are not part of a frame
+        _stats.transactions++;
+        _stats.bytes += 1 + x;
+        _stats.commandBytes += x;
+      }
+    }
+  }
+}
+
+// largest Wire transmission, including the control byte. Only raise it above the
+// default when the application provides a bigger buffer with acquireWireBuffer()
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::setWireBuffer(uint16_t size) {
+  _wireChunk = size - 1;
+}
+
+// startscrollright
+// Activate a right handed scroll for rows start through stop
+// Hint, the display is 16 rows tall. To scroll the whole display, run:
+// display.scrollright(0x00, 0x0F) 
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::startscrollright(uint8_t start, uint8_t stop){
+	uint8_t cmds[] = { SSD1306_RIGHT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X00, 0XFF, SSD1306_ACTIVATE_SCROLL };
+	ssd1306_commandList(cmds, sizeof(cmds));
+}
+
+// startscrollleft
+// Activate a right handed scroll for rows start through stop
+// Hint, the display is 16 rows tall. To scroll the whole display, run:
+// display.scrollright(0x00, 0x0F) 
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::startscrollleft(uint8_t start, uint8_t stop){
+	uint8_t cmds[] = { SSD1306_LEFT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X00, 0XFF, SSD1306_ACTIVATE_SCROLL };
+	ssd1306_commandList(cmds, sizeof(cmds));
+}
+
+// startscrolldiagright
+// Activate a diagonal scroll for rows start through stop
+// Hint, the display is 16 rows tall. To scroll the whole display, run:
+// display.scrollright(0x00, 0x0F) 
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::startscrolldiagright(uint8_t start, uint8_t stop){
+	uint8_t cmds[] = { SSD1306_SET_VERTICAL_SCROLL_AREA, 0X00, H,
+		SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X01, SSD1306_ACTIVATE_SCROLL };
+	ssd1306_commandList(cmds, sizeof(cmds));
+}
+
+// startscrolldiagleft
+// Activate a diagonal scroll for rows start through stop
+// Hint, the display is 16 rows tall. To scroll the whole display, run:
+// display.scrollright(0x00, 0x0F) 
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::startscrolldiagleft(uint8_t start, uint8_t stop){
+	uint8_t cmds[] = { SSD1306_SET_VERTICAL_SCROLL_AREA, 0X00, H,
+		SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X01, SSD1306_ACTIVATE_SCROLL };
+	ssd1306_commandList(cmds, sizeof(cmds));
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::stopscroll(void){
+	ssd1306_command(SSD1306_DEACTIVATE_SCROLL);
+	invalidate();	// scrolling moved the panel's RAM, it has to be rewritten
+}
+
+// setStartLine
+// Show RAM row 'line' at the top of the panel, rows above it wrap to the bottom.
+// Nothing is resent - text scrolls by one row for the cost of one command
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::setStartLine(uint8_t line){
+	ssd1306_command(SSD1306_SETSTARTLINE | (line % H));
+}
+
+// Dim the display
+// dim = true: display is dimmed
+// dim = false: display is normal
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::dim(bool dim) {
+  uint8_t contrast;
+
+  if (dim) {
+    contrast = 0; // Dimmed display
+  } else {
+    if (_vccstate == SSD1306_EXTERNALVCC) {
+      contrast = 0x9F;
+    } else {
+      contrast = 0xCF;
+    }
+  }
+  // the range of contrast to too small to be really useful
+  // it is useful to dim the display
+  uint8_t cmds[] = { SSD1306_SETCONTRAST, contrast };
+  ssd1306_commandList(cmds, sizeof(cmds));
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::ssd1306_data(uint8_t c) {
+  waitDisplay();
+  if (cs != -1)
+  {
+    // SPI
+    spiBegin(HIGH);
+    fastSPIwrite(c);
+    spiEnd();
+  }
+  else
+  {
+    // I2C
+    uint8_t control = 0x40;   // Co = 0, D/C = 1
+    WITH_LOCK(Wire) {
+      Wire.beginTransmission(_i2caddr);
+      Wire.write(control);
+      Wire.write(c);
+      Wire.endTransmission();
+    }
+  }
+}
+
+// send only the columns of each page that changed since the last call
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::display(void) {
+  waitDisplay();
+  flushFrame(buffer, dirtyMin, dirtyMax);
+}
+
+// freeze the current frame and send it from the flush thread, drawing can carry on
+// in the buffer straight away. Waits only if the previous frame is still going out
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::displayAsync(void) {
+  if (_flushThread == NULL) {
+    os_semaphore_create(&_flushStart, 1, 0);
+    os_semaphore_create(&_flushIdle, 1, 1);
+    _flushThread = new Thread("ssd1306", [this]() { flushWorker(); });
+  }
+  os_semaphore_take(_flushIdle, CONCURRENT_WAIT_FOREVER, false);
+
+  for (uint8_t page=0; page<PAGES; page++) {
+    pendingMin[page] = dirtyMin[page];
+    pendingMax[page] = dirtyMax[page];
+    if (dirtyMin[page] <= dirtyMax[page]) {
+      uint16_t offset = page*W + dirtyMin[page];
+      memcpy(&front[offset], &buffer[offset], dirtyMax[page] - dirtyMin[page] + 1);
+    }
+    dirtyMin[page] = 0xFF;
+    dirtyMax[page] = 0;
+  }
+  _busy = true;
+  os_semaphore_give(_flushStart, false);
+}
+
+// block until a frame started with displayAsync() has been sent
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::waitDisplay(void) {
+  if (_flushThread == NULL)
+    return;
+  os_semaphore_take(_flushIdle, CONCURRENT_WAIT_FOREVER, false);
+  os_semaphore_give(_flushIdle, false);
+}
+
+// every transfer holds the bus lock (Wire, or SPI.beginTransaction() for the whole
+// frame on hardware SPI), so code using another device on the same bus from the
+// application thread must take it too, e.g. WITH_LOCK(Wire) { bme.readTemperature(); }.
+// On I2C the lock is released between transmissions, so such a read waits for one
+// chunk rather than a frame; the panel keeps its address pointer across it
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::flushWorker(void) {
+  while (true) {
+    os_semaphore_take(_flushStart, CONCURRENT_WAIT_FOREVER, false);
+    flushFrame(front, pendingMin, pendingMax);
+    _busy = false;
+    os_semaphore_give(_flushIdle, false);
+  }
+}
+
+// send the changed ranges of src and mark them clean
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::flushFrame(const uint8_t *src, uint8_t *rangeMin, uint8_t *rangeMax) {
+  uint32_t start = _statsEnabled ? micros() : 0;
+  _stats.transactions = _stats.bytes = _stats.commandBytes = _stats.dataBytes = 0;
+  _stats.spans = 0;
+  _inFrame = true;  // on SPI the whole frame goes out under one chip select
+
+  for (uint8_t page=0; page<PAGES; page++) {
+    if (rangeMin[page] > rangeMax[page])
+      continue;
+
+    if (_flushMode == SSD1306_FLUSH_DIFF) {
+      if (_shadowValid)
+        sendChanges(src, page, rangeMin[page], rangeMax[page]);
+      else
+        sendWindow(src, page, rangeMin[page], rangeMax[page]);
+      uint16_t offset = page*W + rangeMin[page];
+      memcpy(&shadow[offset], &src[offset], rangeMax[page] - rangeMin[page] + 1);
+    }
+    else {
+      sendWindow(src, page, rangeMin[page], rangeMax[page]);
+    }
+
+    rangeMin[page] = 0xFF;
+    rangeMax[page] = 0;
+  }
+
+  _inFrame = false;
+  if (_spiSelected)
+    spiEnd();
+
+  if (_flushMode == SSD1306_FLUSH_DIFF)
+    _shadowValid = true;
+  _stats.frames++;
+  _stats.totalBytes += _stats.bytes;
+  if (_statsEnabled)
+    recordFrame(micros() - start);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::resetStats(void) {
+  waitDisplay();
+  memset(&_stats, 0, sizeof(_stats));
+  _historyCount = _historyHead = 0;
+}
+
+// add a frame to the rolling window and refresh its min/avg/max
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::recordFrame(uint32_t elapsed) {
+  _stats.micros = elapsed;
+  _historyMicros[_historyHead] = elapsed;
+  _historyBytes[_historyHead] = _stats.bytes;
+  _historyHead = (_historyHead + 1) % SSD1306_STATS_FRAMES;
+  if (_historyCount < SSD1306_STATS_FRAMES)
+    _historyCount++;
+
+  uint32_t sumMicros = 0, sumBytes = 0;
+  _stats.minMicros = _stats.maxMicros = _historyMicros[0];
+  _stats.minBytes = _stats.maxBytes = _historyBytes[0];
+  for (uint8_t i=0; i<_historyCount; i++) {
+    sumMicros += _historyMicros[i];
+    sumBytes += _historyBytes[i];
+    if (_historyMicros[i] < _stats.minMicros) _stats.minMicros = _historyMicros[i];
+    if (_historyMicros[i] > _stats.maxMicros) _stats.maxMicros = _historyMicros[i];
+    if (_historyBytes[i] < _stats.minBytes) _stats.minBytes = _historyBytes[i];
+    if (_historyBytes[i] > _stats.maxBytes) _stats.maxBytes = _historyBytes[i];
+  }
+  _stats.avgMicros = sumMicros / _historyCount;
+  _stats.avgBytes = sumBytes / _historyCount;
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::printStats(Print &out) {
+  waitDisplay();
+  out.printf("ssd1306: %lu frames, %lu bytes\n", (unsigned long)_stats.frames, (unsigned long)_stats.totalBytes);
+  out.printf("  last: %u transactions, %u bytes (%u cmd, %u data), %u spans",
+    _stats.transactions, _stats.bytes, _stats.commandBytes, _stats.dataBytes, _stats.spans);
+  if (_statsEnabled) {
+    out.printf(", %lu us\n", (unsigned long)_stats.micros);
+    out.printf("  last %u: %lu/%lu/%lu us, %u/%u/%u bytes (min/avg/max)\n", _historyCount,
+      (unsigned long)_stats.minMicros, (unsigned long)_stats.avgMicros, (unsigned long)_stats.maxMicros,
+      _stats.minBytes, _stats.avgBytes, _stats.maxBytes);
+  }
+  else {
+    out.printf("\n");
+  }
+}
+
+// SSD1306_FLUSH_DIFF suits code that clears and redraws every frame - the redrawn
+// pixels are mostly the same, so only the bytes that really changed go out
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::setFlushMode(uint8_t mode) {
+  if (mode == _flushMode)
+    return;
+  waitDisplay();
+  _flushMode = mode;
+  invalidate();  // the shadow doesn't know the panel contents yet, first frame is sent whole
+}
+
+// send columns x0..x1 of one page
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::sendWindow(const uint8_t *src, uint8_t page, uint8_t x0, uint8_t x1) {
+  uint8_t window[] = {
+    SSD1306_COLUMNADDR, (uint8_t)(x0 + COLUMN_OFFSET), (uint8_t)(x1 + COLUMN_OFFSET),  // Column start and end address
+    SSD1306_PAGEADDR, page, page  // Page start and end address
+  };
+  sendCommands(window, sizeof(window));
+
+  const uint8_t *pBuf = &src[page*W + x0];
+  uint16_t count = x1 - x0 + 1;
+
+  if (cs != -1)
+  {
+    // SPI
+    spiBegin(HIGH);
+    fastSPIwrite(pBuf, count);
+    spiEnd();
+    _stats.bytes += count;
+    _stats.dataBytes += count;
+  }
+  else
+  {
+    // I2C
+    for (uint16_t i=0; i<count; ) {
+      // send a bunch of data in one xmission
+      uint16_t x;
+      WITH_LOCK(Wire) {
+        Wire.beginTransmission(_i2caddr);
+        Wire.write(0x40);
+        for (x=0; x<_wireChunk && i<count; x++) {
+          Wire.write(pBuf[i]);
+          i++;
+        }
+        Wire.endTransmission();
+      }
+      _stats.transactions++;
+      _stats.bytes += 1 + x;
+      _stats.dataBytes += x;
+    }
+  }
+  _stats.spans++;
+}
+
+// compare columns x0..x1 of one page with the shadow a word at a time and send
+// the changed spans, joining spans separated by SSD1306_SPAN_MERGE bytes or less
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::sendChanges(const uint8_t *src, uint8_t page, uint8_t x0, uint8_t x1) {
+  const uint8_t *cur = &src[page*W];
+  uint8_t *old = &shadow[page*W];
+  int16_t spanStart = -1, spanEnd = -1;
+
+  for (int16_t x=x0; x<=x1; ) {
+    if (((x & 3) == 0) && (x + 3 <= x1) && (memcmp(&cur[x], &old[x], 4) == 0)) {
+      x += 4;
+      continue;
+    }
+    if (cur[x] != old[x]) {
+      if (spanStart >= 0 && (x - spanEnd - 1) > SSD1306_SPAN_MERGE) {
+        sendWindow(src, page, spanStart, spanEnd);
+        spanStart = -1;
+      }
+      if (spanStart < 0)
+        spanStart = x;
+      spanEnd = x;
+    }
+    x++;
+  }
+  if (spanStart >= 0)
+    sendWindow(src, page, spanStart, spanEnd);
+}
+
+// clear everything - only columns that held something need resending
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::clearDisplay(void) {
+  fillScreen(BLACK);
+}
+
+// the whole buffer in one memset, only columns that differ from the fill get resent
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillScreen(uint16_t color) {
+  fillPages(0xFF, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillPages(uint8_t pages, uint16_t color) {
+  uint8_t val = (color == WHITE) ? 0xFF : 0x00;
+  for (uint8_t page=0; page<PAGES; page++) {
+    if (!(pages & (1 << page)))
+      continue;
+    uint8_t *pBuf = &buffer[page*W];
+    int16_t first = 0, last = W-1;
+    while (first <= last && pBuf[first] == val) first++;
+    while (last > first && pBuf[last] == val) last--;
+    if (first <= last)
+      markDirty(page, first, last);
+    memset(pBuf, val, W);
+  }
+}
+
+// glyph columns are already page bytes: at rotation 0 each one is shifted into
+// the pages the character row covers. Sizes 2 and 3 first stretch the column
+// to 16 or 24 bits through a nibble table, then write whole bytes the same way
+inline constexpr uint8_t glyphDouble[16] = {
+  0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+  0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+inline constexpr uint16_t glyphTriple[16] = {
+  0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+  0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF
+};
+
+inline uint32_t scaleGlyphColumn(uint8_t line, uint8_t size) {
+  if (size == 2)
+    return glyphDouble[line & 0x0F] | ((uint32_t)glyphDouble[line >> 4] << 8);
+  if (size == 3)
+    return glyphTriple[line & 0x0F] | ((uint32_t)glyphTriple[line >> 4] << 12);
+  return line;
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+  if (size == 0 || size > 3 || rotation != 0) {
+    Generic::drawChar(x, y, c, color, bg, size);
+    return;
+  }
+  int16_t height = 8 * size;
+  if (clipTest(x, y, 6 * size, height) == GFX_CLIP_OUTSIDE)
+    return;
+
+  // first page touched, rounding down for rows above the screen
+  int16_t page = (y >= 0) ? y / 8 : -((7 - y) / 8);
+  uint8_t shift = y - page * 8;
+  uint8_t bytes = (shift + height + 7) / 8;
+  bool opaque = (bg != color);
+  uint32_t cell = ((uint32_t)1 << height) - 1;
+
+  // rows of each page inside the panel and the clip rectangle
+  uint8_t keep[4];
+  for (uint8_t k=0; k<bytes; k++) {
+    int16_t p = page + k;
+    keep[k] = (p >= 0 && p < PAGES) ? clipRows(p) : 0;
+  }
+
+  for (int8_t i=0; i<6; i++) {
+    uint32_t line = scaleGlyphColumn((i < 5) ? glcdfont[c*5 + i] : 0, size);
+    uint32_t paint = opaque ? cell : line;   // bits this character owns
+    uint32_t white = (color == WHITE) ? line : 0;
+    if (opaque && bg == WHITE)
+      white |= cell & ~line;
+    paint <<= shift;
+    white <<= shift;
+
+    for (uint8_t repeat=0; repeat<size; repeat++) {
+      int16_t col = x + i * size + repeat;
+      if (col < _clipLeft || col >= _clipRight)
+        continue;
+      for (uint8_t k=0; k<bytes; k++) {
+        int16_t p = page + k;
+        uint8_t mask = (paint >> (8 * k)) & keep[k];
+        if (!mask)
+          continue;
+        uint8_t *pBuf = &buffer[p*W + col];
+        uint8_t val = (*pBuf & ~mask) | ((white >> (8 * k)) & mask);
+        if (val != *pBuf) {
+          *pBuf = val;
+          markDirty(p, col, col);
+        }
+      }
+    }
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+  drawSpriteInternal(x, y, bitmap, NULL, w, h, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h) {
+  drawSpriteInternal(x, y, bitmap, mask, w, h, WHITE);
+}
+
+// one source page at a time, each landing in one or two buffer pages
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawSpriteInternal(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h, uint16_t color) {
+  if (clipTest(x, y, w, h) == GFX_CLIP_OUTSIDE)
+    return;
+  if (rotation != 0) {
+    for (int16_t j=0; j<h; j++) {
+      for (int16_t i=0; i<w; i++) {
+        uint8_t bit = 1 << (j & 7);
+        uint16_t offset = (j / 8) * w + i;
+        if (mask == NULL) {
+          if (bitmap[offset] & bit)
+            pixel(x + i, y + j, color);
+        } else if (mask[offset] & bit) {
+          pixel(x + i, y + j, (bitmap[offset] & bit) ? WHITE : BLACK);
+        }
+      }
+    }
+    return;
+  }
+
+  for (int16_t top=0; top<h; top+=8) {
+    uint16_t offset = (top / 8) * w;
+    uint8_t rows = (h - top >= 8) ? 0xFF : (0xFF >> (8 - (h - top)));
+    blitStrip(x, y + top, bitmap + offset, mask ? mask + offset : NULL, rows, w, color);
+  }
+}
+
+// 8 rows of columns at any x, y: clipped, then split across the pages it covers
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::blitStrip(int16_t x, int16_t y, const uint8_t *columns, const uint8_t *mask, uint8_t rows, int16_t width, uint16_t color) {
+  if (x >= _clipRight || y >= _clipBottom || x + width <= _clipLeft || y + 8 <= _clipTop)
+    return;
+  if (x < _clipLeft) {
+    columns += _clipLeft - x;
+    if (mask) mask += _clipLeft - x;
+    width -= _clipLeft - x;
+    x = _clipLeft;
+  }
+  if (x + width > _clipRight)
+    width = _clipRight - x;
+
+  // y is at least -7 here, so y + 8 is positive
+  int8_t page = (y + 8) / 8 - 1;
+  uint8_t shift = (y + 8) & 7;
+
+  if (page >= 0)
+    blitPage(page, x, columns, mask, rows, width, shift, color);
+  if (shift && page + 1 < PAGES)
+    blitPage(page + 1, x, columns, mask, rows, width, shift - 8, color);
+}
+
+// columns shifted down (shift > 0) or up (shift < 0) into one page, 'rows' masks
+// off bits below the bottom of the image, and rows outside the clip rectangle are kept
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::blitPage(uint8_t page, int16_t x, const uint8_t *columns, const uint8_t *mask, uint8_t rows, int16_t width, int8_t shift, uint16_t color) {
+  uint8_t keep = clipRows(page);
+  if (!keep)
+    return;
+  uint8_t *pBuf = &buffer[page*W + x];
+  int16_t first = -1, last = 0;
+  for (int16_t i=0; i<width; i++) {
+    uint8_t bits = columns[i] & rows;
+    uint8_t paint, white;
+    if (mask) {
+      paint = mask[i] & rows;
+      white = bits & paint;
+    } else {
+      paint = bits;
+      white = (color == WHITE) ? bits : 0;
+    }
+    if (shift >= 0) {
+      paint <<= shift;
+      white <<= shift;
+    } else {
+      paint >>= -shift;
+      white >>= -shift;
+    }
+    paint &= keep;
+    white &= keep;
+    uint8_t val = (pBuf[i] & ~paint) | white;
+    if (val != pBuf[i]) {
+      pBuf[i] = val;
+      if (first < 0) first = i;
+      last = i;
+    }
+  }
+  if (first >= 0)
+    markDirty(page, x + first, x + last);
+}
+
+// outlines and bitmaps have no page-native form, so they take the shared
+// algorithms with pixel() and the spans inlined instead of called virtually
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  Generic::drawCircle(x0, y0, r, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+  Generic::drawRoundRect(x, y, w, h, r, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+  Generic::drawBitmap(x, y, bitmap, w, h, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+  Generic::drawCircleHelper(x0, y0, r, cornername, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, int16_t delta, uint16_t color) {
+  Generic::fillCircleHelper(x0, y0, r, cornername, delta, color);
+}
+
+// Bresenham as in Adafruit_GFX, so the same pixels are lit, but clipped once up
+// front and drawn as runs: a shallow line is a few horizontal spans, a steep one a
+// few vertical spans, each written straight into the page bytes
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (rotation != 0) {
+    Generic::drawLine(x0, y0, x1, y1, color);
+    return;
+  }
+  // both ends beyond the same edge, nothing to draw
+  if (outcode(x0, y0) & outcode(x1, y1))
+    return;
+
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    swap(x0, y0);
+    swap(x1, y1);
+  }
+  if (x0 > x1) {
+    swap(x0, x1);
+    swap(y0, y1);
+  }
+
+  int16_t dx = x1 - x0, dy = abs(y1 - y0);
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  int16_t err = dx / 2;
+  // the clip rectangle along the major and minor axes
+  int16_t majorLo = steep ? _clipTop : _clipLeft, majorHi = steep ? _clipBottom : _clipRight;
+  int16_t minorLo = steep ? _clipLeft : _clipTop, minorHi = steep ? _clipRight : _clipBottom;
+
+  // skip the steps before the clip edge, advancing y and the error term as
+  // the loop would have (x1 >= majorLo here, so dx > 0)
+  if (x0 < majorLo) {
+    int32_t steps = majorLo - x0;
+    int32_t skipped = steps * dy - err;
+    int32_t ysteps = (skipped > 0) ? (skipped + dx - 1) / dx : 0;
+    y0 += ystep * ysteps;
+    err = err - steps * dy + ysteps * dx;
+    x0 = majorLo;
+  }
+  if (x1 >= majorHi)
+    x1 = majorHi - 1;
+
+  int16_t run = x0;
+  for (; x0 <= x1; x0++) {
+    err -= dy;
+    if (err < 0) {
+      lineRun(steep, run, x0, y0, color);
+      y0 += ystep;
+      err += dx;
+      run = x0 + 1;
+      // left the clip rectangle for good
+      if ((ystep > 0) ? (y0 >= minorHi) : (y0 < minorLo))
+        return;
+    }
+  }
+  if (run <= x1)
+    lineRun(steep, run, x1, y0, color);
+}
+
+// pixels a..b along the major axis at minor coordinate m, the internals clip
+template <int16_t W, int16_t H>
+inline void Adafruit_SSD1306T<W, H>::lineRun(bool steep, int16_t a, int16_t b, int16_t m, uint16_t color) {
+  if (steep)
+    drawFastVLineInternal(m, a, b - a + 1, color);
+  else
+    drawFastHLineInternal(a, m, b - a + 1, color);
+}
+
+// Filled shapes light exactly the pixels the Adafruit_GFX versions do, but at
+// rotation 0 each column (circles, corners) or row (triangles) becomes one span
+// written straight into the page bytes, instead of overlapping virtual line calls
+
+// half height of each column of a filled circle, offsets 0..r from the centre:
+// the midpoint walk of Adafruit_GFX::fillCircleHelper, keeping the tallest span
+// it draws in every column. -1 marks a column it never reaches (usually the
+// centre, which fillCircle() draws itself)
+inline void circleSpans(int16_t r, int16_t *half) {
+  for (int16_t d=0; d<=r; d++) {
+    half[d] = -1;
+  }
+
+  int16_t f     = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x     = 0;
+  int16_t y     = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f     += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f     += ddF_x;
+    if (y > half[x]) half[x] = y;
+    if (x > half[y]) half[y] = x;
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  if (rotation != 0 || r >= W) {
+    Generic::fillCircle(x0, y0, r, color);
+    return;
+  }
+  if (r < 0 || clipTest(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1) == GFX_CLIP_OUTSIDE)
+    return;
+
+  int16_t half[W];
+  circleSpans(r, half);
+  half[0] = r;
+  for (int16_t d=0; d<=r; d++) {
+    if (half[d] < 0)
+      continue;
+    drawFastVLineInternal(x0 + d, y0 - half[d], 2 * half[d] + 1, color);
+    if (d)
+      drawFastVLineInternal(x0 - d, y0 - half[d], 2 * half[d] + 1, color);
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+  if (rotation != 0 || r < 0 || r >= W) {
+    Adafruit_GFX::fillRoundRect(x, y, w, h, r, color);
+    return;
+  }
+  if (roundRectClipped(x, y, w, h, r))
+    return;
+  fillRectInternal(x + r, y, w - 2 * r, h, color);
+
+  // corner columns, stretched by the straight part of the sides
+  int16_t half[W];
+  int16_t delta = h - 2 * r - 1;
+  circleSpans(r, half);
+  for (int16_t d=0; d<=r; d++) {
+    if (half[d] < 0)
+      continue;
+    drawFastVLineInternal(x + w - r - 1 + d, y + r - half[d], 2 * half[d] + 1 + delta, color);
+    drawFastVLineInternal(x + r - d, y + r - half[d], 2 * half[d] + 1 + delta, color);
+  }
+}
+
+// the scanline walk of Adafruit_GFX::fillTriangle, starting at the top of the
+// clip rectangle and stopping at its bottom. Row spans are collected and written a page
+// (8 rows) at a time, so each byte is touched once
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+  if (rotation != 0) {
+    Adafruit_GFX::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+    return;
+  }
+  if (triangleClipped(x0, y0, x1, y1, x2, y2))
+    return;
+
+  int16_t a, b, y, last;
+
+  // Sort coordinates by Y order (y2 >= y1 >= y0)
+  if (y0 > y1) {
+    swap(y0, y1); swap(x0, x1);
+  }
+  if (y1 > y2) {
+    swap(y2, y1); swap(x2, x1);
+  }
+  if (y0 > y1) {
+    swap(y0, y1); swap(x0, x1);
+  }
+
+  if (y0 == y2) {
+    a = b = x0;
+    if (x1 < a)      a = x1;
+    else if (x1 > b) b = x1;
+    if (x2 < a)      a = x2;
+    else if (x2 > b) b = x2;
+    drawFastHLineInternal(a, y0, b - a + 1, color);
+    return;
+  }
+
+  int16_t
+    dx01 = x1 - x0,
+    dy01 = y1 - y0,
+    dx02 = x2 - x0,
+    dy02 = y2 - y0,
+    dx12 = x2 - x1,
+    dy12 = y2 - y1,
+    sa   = 0,
+    sb   = 0;
+
+  // upper part, segments 0-1 and 0-2 (scanline y1 only when the bottom is flat)
+  if (y1 == y2) last = y1;
+  else          last = y1 - 1;
+
+  int16_t left[H], right[H];
+  y = y0;
+  if (y < _clipTop) {
+    int16_t skip = ((last < _clipTop) ? last + 1 : _clipTop) - y0;
+    sa = dx01 * skip;
+    sb = dx02 * skip;
+    y += skip;
+  }
+  int16_t top = y;
+  for (; y <= last && y < _clipBottom; y++) {
+    a   = x0 + sa / dy01;
+    b   = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b) swap(a, b);
+    left[y] = a;
+    right[y] = b;
+  }
+
+  // lower part, segments 0-2 and 1-2
+  if (y < _clipTop) y = _clipTop;
+  sa = dx12 * (y - y1);
+  sb = dx02 * (y - y0);
+  for (; y <= y2 && y < _clipBottom; y++) {
+    a   = x1 + sa / dy12;
+    b   = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b) swap(a, b);
+    left[y] = a;
+    right[y] = b;
+  }
+  fillRowSpans(top, y - 1, left, right, color);
+}
+
+// rows top..bottom, row y covering columns left[y]..right[y]. Per page, the columns
+// every row covers take one combined mask; only the ragged edges go row by row
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillRowSpans(int16_t top, int16_t bottom, int16_t *left, int16_t *right, uint16_t color) {
+  if (top < _clipTop) top = _clipTop;
+  if (bottom >= _clipBottom) bottom = _clipBottom - 1;
+  for (int16_t y=top; y<=bottom; y++) {
+    if (left[y] < _clipLeft) left[y] = _clipLeft;
+    if (right[y] >= _clipRight) right[y] = _clipRight - 1;
+  }
+
+  for (int16_t page = top / 8; page <= bottom / 8; page++) {
+    uint8_t rows = 0;
+    int16_t lo = W, hi = -1, innerLo = _clipLeft, innerHi = _clipRight - 1;
+    for (uint8_t r=0; r<8; r++) {
+      int16_t y = page * 8 + r;
+      if (y < top || y > bottom || left[y] > right[y])
+        continue;
+      rows |= 1 << r;
+      if (left[y] < lo) lo = left[y];
+      if (right[y] > hi) hi = right[y];
+      if (left[y] > innerLo) innerLo = left[y];
+      if (right[y] < innerHi) innerHi = right[y];
+    }
+    if (!rows)
+      continue;
+    markDirty(page, lo, hi);
+
+    uint8_t *pBuf = &buffer[page * W];
+    if (innerLo > innerHi) {
+      // no column shared by every row, plain row spans
+      for (uint8_t r=0; r<8; r++) {
+        int16_t y = page * 8 + r;
+        if (rows & (1 << r))
+          spanBits(pBuf, left[y], right[y], 1 << r, color);
+      }
+      continue;
+    }
+    spanBits(pBuf, innerLo, innerHi, rows, color);
+    for (uint8_t r=0; r<8; r++) {
+      int16_t y = page * 8 + r;
+      if (!(rows & (1 << r)))
+        continue;
+      spanBits(pBuf, left[y], innerLo - 1, 1 << r, color);
+      spanBits(pBuf, innerHi + 1, right[y], 1 << r, color);
+    }
+  }
+}
+
+// set or clear 'mask' in bytes x0..x1 of one page row
+template <int16_t W, int16_t H>
+inline void Adafruit_SSD1306T<W, H>::spanBits(uint8_t *pBuf, int16_t x0, int16_t x1, uint8_t mask, uint16_t color) {
+  if (color == WHITE) {
+    for (int16_t x=x0; x<=x1; x++) pBuf[x] |= mask;
+  } else {
+    mask = ~mask;
+    for (int16_t x=x0; x<=x1; x++) pBuf[x] &= mask;
+  }
+}
+
+// a rectangle stays a rectangle under rotation, so map it to panel coordinates once
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  rect(x, y, w, h, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  toPanel(x, y, w, h);
+  fillRectInternal(x, y, w, h, color);
+}
+
+// page by page: a masked read-modify-write on partial top and bottom pages,
+// whole pages are a memset of the covered columns
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::fillRectInternal(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if(x < _clipLeft) { w -= _clipLeft - x; x = _clipLeft; }
+  if(y < _clipTop) { h -= _clipTop - y; y = _clipTop; }
+  if(x + w > _clipRight) { w = _clipRight - x; }
+  if(y + h > _clipBottom) { h = _clipBottom - y; }
+  if(w <= 0 || h <= 0) { return; }
+
+  uint8_t firstPage = y / 8, lastPage = (y + h - 1) / 8;
+  uint8_t topMask = 0xFF << (y & 7);
+  uint8_t bottomMask = 0xFF >> (7 - ((y + h - 1) & 7));
+
+  for (uint8_t page = firstPage; page <= lastPage; page++) {
+    uint8_t mask = 0xFF;
+    if (page == firstPage) mask &= topMask;
+    if (page == lastPage) mask &= bottomMask;
+
+    markDirty(page, x, x + w - 1);
+    uint8_t *pBuf = &buffer[page*W + x];
+    if (mask == 0xFF) {
+      memset(pBuf, (color == WHITE) ? 0xFF : 0x00, w);
+    } else if (color == WHITE) {
+      for (int16_t i=0; i<w; i++) pBuf[i] |= mask;
+    } else {
+      mask = ~mask;
+      for (int16_t i=0; i<w; i++) pBuf[i] &= mask;
+    }
+  }
+}
+
+// copy a saved layer back, only the columns that differ from it are marked dirty
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::restoreLayer(const uint8_t *layer) {
+  for (uint8_t page=0; page<PAGES; page++) {
+    const uint8_t *pBuf = &buffer[page*W], *pLayer = &layer[page*W];
+    int16_t first = 0, last = W-1;
+    while (first <= last && pBuf[first] == pLayer[first]) first++;
+    while (last > first && pBuf[last] == pLayer[last]) last--;
+    if (first <= last)
+      markDirty(page, first, last);
+  }
+  memcpy(buffer, layer, BUFFER_SIZE);
+}
+
+// mark the whole buffer as changed, e.g. after the panel was reset or written elsewhere
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::invalidate(void) {
+  waitDisplay();  // the flush thread sets _shadowValid when it finishes
+  _shadowValid = false;
+  for (uint8_t page=0; page<PAGES; page++) {
+    dirtyMin[page] = 0;
+    dirtyMax[page] = W-1;
+  }
+}
+
+
+template <int16_t W, int16_t H>
+inline void Adafruit_SSD1306T<W, H>::fastSPIwrite(uint8_t d) {
+  
+  if(hwSPI) {
+    (void)SPI.transfer(d);
+  } else {
+    shiftOut(sid, sclk, MSBFIRST, d);		// SSD1306 specs show MSB out first
+  }
+}
+
+// a block in one DMA transfer on hardware SPI (blocking, no callback)
+template <int16_t W, int16_t H>
+inline void Adafruit_SSD1306T<W, H>::fastSPIwrite(const uint8_t *d, uint16_t n) {
+
+  if(hwSPI) {
+    SPI.transfer((uint8_t *)d, NULL, n, NULL);
+  } else {
+    for (uint16_t i=0; i<n; i++) {
+      shiftOut(sid, sclk, MSBFIRST, d[i]);
+    }
+  }
+}
+
+// select the panel for commands (LOW) or data (HIGH). Inside a frame chip select
+// stays asserted and only D/C changes, which the SSD1306 samples per byte. Hardware
+// SPI is held with beginTransaction() while selected, which also restores our
+// clock and mode if another device on the bus changed them
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::spiBegin(uint8_t dcLevel) {
+  if (_spiSelected) {
+    digitalWrite(dc, dcLevel);
+    return;
+  }
+  if (hwSPI)
+    SPI.beginTransaction(SPISettings(SSD1306_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+  digitalWrite(cs, HIGH);
+  digitalWrite(dc, dcLevel);
+  digitalWrite(cs, LOW);
+  _spiSelected = true;
+  if (_inFrame)
+    _stats.transactions++;
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::spiEnd(void) {
+  if (_inFrame)
+    return;
+  digitalWrite(cs, HIGH);
+  if (hwSPI)
+    SPI.endTransaction();
+  _spiSelected = false;
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  hspan(x, y, w, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::hspan(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  boolean bSwap = false;
+  switch(rotation) { 
+    case 0:
+      // 0 degree rotation, do nothing
+      break;
+    case 1:
+      // 90 degree rotation, swap x & y for rotation, then invert x
+      bSwap = true;
+      swap(x, y);
+      x = W - x - 1;
+      break;
+    case 2:
+      // 180 degree rotation, invert x and y - then shift y around for height.
+      x = W - x - 1;
+      y = H - y - 1;
+      x -= (w-1);
+      break;
+    case 3:
+      // 270 degree rotation, swap x & y for rotation, then invert y  and adjust y for w (not to become h)
+      bSwap = true;
+      swap(x, y);
+      y = H - y - 1;
+      y -= (w-1);
+      break;
+  }
+
+  if(bSwap) { 
+    drawFastVLineInternal(x, y, w, color);
+  } else { 
+    drawFastHLineInternal(x, y, w, color);
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  // Do bounds/limit checks, against the clip rectangle
+  if(y < _clipTop || y >= _clipBottom) { return; }
+
+  // make sure we don't try to draw left of the clip
+  if(x < _clipLeft) { 
+    w -= _clipLeft - x;
+    x = _clipLeft;
+  }
+
+  // make sure we don't go past its right edge
+  if( (x + w) > _clipRight) { 
+    w = (_clipRight - x);
+  }
+
+  // if our width is now negative, punt
+  if(w <= 0) { return; }
+
+  markDirty(y/8, x, x + w - 1);
+
+  // set up the pointer for  movement through the buffer
+  uint8_t *pBuf = buffer;
+  // adjust the buffer pointer for the current row
+  pBuf += ((y/8) * W);
+  // and offset x columns in
+  pBuf += x;
+
+  uint8_t mask = 1 << (y&7);
+
+  if(color == WHITE) { 
+    while(w--) { *pBuf++ |= mask; }
+  } else {
+    mask = ~mask;
+    while(w--) { *pBuf++ &= mask; }
+  }
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  vspan(x, y, h, color);
+}
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::vspan(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  bool bSwap = false;
+  switch(rotation) { 
+    case 0:
+      break;
+    case 1:
+      // 90 degree rotation, swap x & y for rotation, then invert x and adjust x for h (now to become w)
+      bSwap = true;
+      swap(x, y);
+      x = W - x - 1;
+      x -= (h-1);
+      break;
+    case 2:
+      // 180 degree rotation, invert x and y - then shift y around for height.
+      x = W - x - 1;
+      y = H - y - 1;
+      y -= (h-1);
+      break;
+    case 3:
+      // 270 degree rotation, swap x & y for rotation, then invert y 
+      bSwap = true;
+      swap(x, y);
+      y = H - y - 1;
+      break;
+  }
+
+  if(bSwap) { 
+    drawFastHLineInternal(x, y, h, color);
+  } else {
+    drawFastVLineInternal(x, y, h, color);
+  }
+}
+
+
+template <int16_t W, int16_t H>
+void Adafruit_SSD1306T<W, H>::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h, uint16_t color) {
+
+  // do nothing if we're off the left or right side of the clip rectangle
+  if(x < _clipLeft || x >= _clipRight) { return; }
+
+  // make sure we don't try to draw above its top
+  if(__y < _clipTop) { 
+    __h -= _clipTop - __y;
+    __y = _clipTop;
+
+  } 
+
+  // make sure we don't go past its bottom
+  if( (__y + __h) > _clipBottom) { 
+    __h = (_clipBottom - __y);
+  }
+
+  // if our height is now negative, punt 
+  if(__h <= 0) { 
+    return;
+  }
+
+  // this display doesn't need ints for coordinates, use local byte registers for faster juggling
+  uint8_t y = __y;
+  uint8_t h = __h;
+
+  for (uint8_t page = y/8; page <= (y+h-1)/8; page++) {
+    markDirty(page, x, x);
+  }
+
+
+  // set up the pointer for fast movement through the buffer
+  uint8_t *pBuf = buffer;
+  // adjust the buffer pointer for the current row
+  pBuf += ((y/8) * W);
+  // and offset x columns in
+  pBuf += x;
+
+  // do the first partial byte, if necessary - this requires some masking
+  uint8_t mod = (y&7);
+  if(mod) {
+    // mask off the high n bits we want to set 
+    mod = 8-mod;
+
+    // note - lookup table results in a nearly 10% performance improvement in fill* functions
+    // register uint8_t mask = ~(0xFF >> (mod));
+    static uint8_t premask[8] = {0x00, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE };
+    uint8_t mask = premask[mod];
+
+    // adjust the mask if we're not going to reach the end of this byte
+    if( h < mod) { 
+      mask &= (0XFF >> (mod-h));
+    }
+
+    if(color == WHITE) { 
+      *pBuf |= mask;
+    } else {
+      *pBuf &= ~mask;
+    }
+
+    // fast exit if we're done here!
+    if(h<mod) { return; }
+
+    h -= mod;
+
+    pBuf += W;
+  }
+
+
+  // write solid bytes while we can - effectively doing 8 rows at a time
+  if(h >= 8) { 
+    // store a local value to work with 
+    uint8_t val = (color == WHITE) ? 255 : 0;
+
+    do  {
+      // write our value in
+      *pBuf = val;
+
+      // adjust the buffer forward 8 rows worth of data
+      pBuf += W;
+
+      // adjust h & y (there's got to be a faster way for me to do this, but this should still help a fair bit for now)
+      h -= 8;
+    } while(h >= 8);
+  }
+
+  // now do the final partial byte, if necessary
+  if(h) {
+    mod = h & 7;
+    // this time we want to mask the low bits of the byte, vs the high bits we did above
+    // register uint8_t mask = (1 << mod) - 1;
+    // note - lookup table results in a nearly 10% performance improvement in fill* functions
+    static uint8_t postmask[8] = {0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F };
+    uint8_t mask = postmask[mod];
+    if(color == WHITE) { 
+      *pBuf |= mask;
+    } else { 
+      *pBuf &= ~mask;
+    }
+  }
+}
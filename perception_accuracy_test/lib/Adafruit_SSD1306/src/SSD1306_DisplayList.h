@@ -0,0 +1,362 @@
+#ifndef _SSD1306_DISPLAYLIST_H
+#define _SSD1306_DISPLAYLIST_H
+
+/*********************************************************************
+A display list for SSD1306 screens. Drawing calls are recorded as small
+commands, each with the mask of panel pages (8 pixel rows) its bounding
+box covers, and rasterized at end() one page at a time: the clip rectangle
+is set to the page and only the commands touching it are drawn, in the
+order they were recorded. Pages no command touches are not visited at all,
+and with begin() they are not cleared either, so a frame that only moves a
+few things leaves the rest of the buffer and its dirty columns alone.
+
+  SSD1306DisplayList<Adafruit_SSD1306> list(display);
+  list.begin();                   // pages drawn since the last begin() or in this frame start black
+  list.drawText(0, 0, "SCORE", WHITE);
+  list.fillCircle(x, y, 4, WHITE);
+  list.end();                     // rasterize, then display() as usual
+  display.display();
+
+With begin(false) the commands are drawn over the buffer as it is, like
+direct drawing, and the next begin() still blanks the pages they touched.
+The output is the same as making the calls directly.
+
+Record and end() in the same rotation. Text and bitmaps are kept by
+pointer until end(). A full list is rasterized early and recording
+carries on, so order is kept. end() leaves the clip rectangle reset to
+the whole screen.
+*********************************************************************/
+
+#include "Adafruit_SSD1306.h"
+
+#ifndef SSD1306_LIST_COMMANDS
+  #define SSD1306_LIST_COMMANDS 32
+#endif
+
+template <class Display, uint8_t N = SSD1306_LIST_COMMANDS>
+class SSD1306DisplayList {
+ public:
+  SSD1306DisplayList(Display &display)
+    : _display(display), _count(0), _clear(false), _lastPages(0), _framePages(0), _donePages(0) {}
+
+  // start recording a frame. With clear, every page drawn by this frame or any
+  // since the previous cleared one is blanked before its commands, the others are kept
+  void begin(bool clear = true) {
+    _count = 0;
+    _clear = clear;
+    _framePages = 0;
+    _donePages = 0;
+  }
+
+  // rasterize what was recorded
+  void end(void) {
+    uint8_t pages = recorded();
+    if (_clear)
+      pages |= _lastPages & ~_donePages;
+    rasterize(pages);
+    if (_clear)
+      _lastPages = _framePages;
+    else
+      _lastPages |= _framePages;  // the next cleared frame has to blank these too
+    _count = 0;
+    _display.resetClipRect();
+  }
+
+  // pages the frame recorded so far draws into
+  uint8_t pages(void) { return _framePages; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    Command *c = add(x, y, 1, 1);
+    if (c) set(c, PIXEL, color, x, y);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    Command *c = add(x, y, w, 1);
+    if (c) set(c, HLINE, color, x, y, w);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    Command *c = add(x, y, 1, h);
+    if (c) set(c, VLINE, color, x, y, h);
+  }
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    Command *c = add((x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1, abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+    if (c) set(c, LINE, color, x0, y0, x1, y1);
+  }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Command *c = add(x, y, w, h);
+    if (c) set(c, RECT, color, x, y, w, h);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Command *c = add(x, y, w, h);
+    if (c) set(c, FILL_RECT, color, x, y, w, h);
+  }
+  void fillScreen(uint16_t color) {
+    fillRect(0, 0, _display.width(), _display.height(), color);
+  }
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    Command *c = add(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1);
+    if (c) set(c, CIRCLE, color, x0, y0, r);
+  }
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    Command *c = add(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1);
+    if (c) set(c, FILL_CIRCLE, color, x0, y0, r);
+  }
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    Command *c = addRoundRect(x, y, w, h, r);
+    if (c) set(c, ROUND_RECT, color, x, y, w, h, r);
+  }
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    Command *c = addRoundRect(x, y, w, h, r);
+    if (c) set(c, FILL_ROUND_RECT, color, x, y, w, h, r);
+  }
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    Command *c = addTriangle(x0, y0, x1, y1, x2, y2);
+    if (c) set(c, TRIANGLE, color, x0, y0, x1, y1, x2, y2);
+  }
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    Command *c = addTriangle(x0, y0, x1, y1, x2, y2);
+    if (c) set(c, FILL_TRIANGLE, color, x0, y0, x1, y1, x2, y2);
+  }
+  void drawChar(int16_t x, int16_t y, unsigned char ch, uint16_t color, uint16_t bg, uint8_t size) {
+    Command *c = add(x, y, 6 * size, 8 * size);
+    if (c) {
+      set(c, CHAR, color, x, y, ch, bg);
+      c->size = size;
+    }
+  }
+  // one line of text with the built-in font, no wrapping or control characters.
+  // Background pixels are left alone unless bg differs from color
+  void drawText(int16_t x, int16_t y, const char *text, uint16_t color, uint16_t bg = 0xFFFF, uint8_t size = 1) {
+    Command *c = add(x, y, strlen(text) * 6 * size, 8 * size);
+    if (c) {
+      set(c, TEXT, color, x, y, (bg == 0xFFFF) ? color : bg);
+      c->size = size;
+      c->data = text;
+    }
+  }
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    Command *c = add(x, y, w, h);
+    if (c) {
+      set(c, BITMAP, color, x, y, w, h);
+      c->data = bitmap;
+    }
+  }
+  void drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color = WHITE) {
+    drawSprite(x, y, bitmap, NULL, w, h, color);
+  }
+  void drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h) {
+    drawSprite(x, y, bitmap, mask, w, h, WHITE);
+  }
+  // rotation 0 only, as on the display
+  template <size_t L>
+  void blitText(int16_t x, int16_t y, const SSD1306Text<L> &text, uint16_t color = WHITE) {
+    blitColumns(x, y, text.columns, text.WIDTH, color);
+  }
+  void blitColumns(int16_t x, int16_t y, const uint8_t *columns, int16_t width, uint16_t color) {
+    Command *c = add(x, y, width, 8);
+    if (c) {
+      set(c, COLUMNS, color, x, y, width);
+      c->data = columns;
+    }
+  }
+
+ private:
+  enum {
+    PIXEL, HLINE, VLINE, LINE, RECT, FILL_RECT, CIRCLE, FILL_CIRCLE, ROUND_RECT,
+    FILL_ROUND_RECT, TRIANGLE, FILL_TRIANGLE, CHAR, TEXT, BITMAP, SPRITE, COLUMNS
+  };
+
+  struct Command {
+    uint8_t op, color, pages, size;
+    int16_t a[6];
+    const void *data, *mask;
+  };
+
+  Display &_display;
+  Command _list[N];
+  uint8_t _count;
+  bool _clear;
+  uint8_t _lastPages;    // drawn since the previous cleared frame began
+  uint8_t _framePages;   // drawn by this frame so far
+  uint8_t _donePages;    // cleared this frame already
+
+  void set(Command *c, uint8_t op, uint16_t color, int16_t a0, int16_t a1, int16_t a2 = 0,
+    int16_t a3 = 0, int16_t a4 = 0, int16_t a5 = 0) {
+    c->op = op;
+    c->color = color;
+    c->a[0] = a0; c->a[1] = a1; c->a[2] = a2;
+    c->a[3] = a3; c->a[4] = a4; c->a[5] = a5;
+  }
+
+  void drawSprite(int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, int16_t w, int16_t h, uint16_t color) {
+    Command *c = add(x, y, w, h);
+    if (c) {
+      set(c, SPRITE, color, x, y, w, h);
+      c->data = bitmap;
+      c->mask = mask;
+    }
+  }
+
+  // a slot for a command drawing within x, y, w, h, or NULL when that is off screen
+  Command *add(int16_t x, int16_t y, int16_t w, int16_t h) {
+    uint8_t pages = pagesOf(x, y, w, h);
+    if (!pages)
+      return NULL;
+    if (_count == N) {
+      // out of room: finish the pages recorded so far, later commands still land on top
+      rasterize(recorded());
+      _count = 0;
+    }
+    _framePages |= pages;
+    Command *c = &_list[_count++];
+    c->pages = pages;
+    c->size = 1;
+    c->data = c->mask = NULL;
+    return c;
+  }
+
+  // pages touched by the commands in the list
+  uint8_t recorded(void) {
+    uint8_t pages = 0;
+    for (uint8_t i=0; i<_count; i++) {
+      pages |= _list[i].pages;
+    }
+    return pages;
+  }
+
+  // the corner arcs reach past x, y, w, h when r is more than half the side
+  Command *addRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r) {
+    int16_t left = x, right = x + w - 1, top = y, bottom = y + h - 1;
+    if (x + w - 2 * r - 1 < left) left = x + w - 2 * r - 1;
+    if (x + 2 * r > right) right = x + 2 * r;
+    if (y + h - 2 * r - 1 < top) top = y + h - 2 * r - 1;
+    if (y + 2 * r > bottom) bottom = y + 2 * r;
+    return add(left, top, right - left + 1, bottom - top + 1);
+  }
+
+  Command *addTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    int16_t left = x0, right = x0, top = y0, bottom = y0;
+    if (x1 < left) left = x1; else if (x1 > right) right = x1;
+    if (x2 < left) left = x2; else if (x2 > right) right = x2;
+    if (y1 < top) top = y1; else if (y1 > bottom) bottom = y1;
+    if (y2 < top) top = y2; else if (y2 > bottom) bottom = y2;
+    return add(left, top, right - left + 1, bottom - top + 1);
+  }
+
+  // panel pages covered by a box in the current rotation, one bit each
+  uint8_t pagesOf(int32_t x, int32_t y, int32_t w, int32_t h) {
+    const int16_t rows = Display::PAGES * 8;
+    if (w <= 0 || h <= 0 || x >= _display.width() || y >= _display.height() || x + w <= 0 || y + h <= 0)
+      return 0;
+    int32_t first, last;
+    switch (_display.getRotation()) {
+    case 1:
+      first = x;
+      last = x + w - 1;
+      break;
+    case 2:
+      first = rows - y - h;
+      last = rows - y - 1;
+      break;
+    case 3:
+      first = rows - x - w;
+      last = rows - x - 1;
+      break;
+    default:
+      first = y;
+      last = y + h - 1;
+    }
+    if (first < 0) first = 0;
+    if (last >= rows) last = rows - 1;
+    return (0xFF << (first / 8)) & (0xFF >> (7 - last / 8));
+  }
+
+  // page by page: blank the page when clearing (only the columns that were not
+  // black become dirty), then draw the commands that touch it, clipped to it. A
+  // command spanning several pages carries on into the following ones when no
+  // earlier command still has to draw there, so big shapes are walked once
+  void rasterize(uint8_t pages) {
+    uint8_t todo[N];
+    for (uint8_t i=0; i<_count; i++) {
+      todo[i] = _list[i].pages;
+    }
+    for (uint8_t page=0; page<Display::PAGES; page++) {
+      uint8_t bit = 1 << page;
+      if (!(pages & bit))
+        continue;
+      clearPage(page);
+      uint8_t pending = 0;   // pages earlier commands have yet to draw
+      for (uint8_t i=0; i<_count; i++) {
+        if (todo[i] & bit) {
+          uint8_t last = page;
+          while (last + 1 < Display::PAGES && (todo[i] & ~pending & (2 << last))) {
+            clearPage(++last);
+          }
+          setBand(page, last);
+          draw(_list[i]);
+          todo[i] &= ~((0xFF << page) & (0xFF >> (7 - last)));
+        }
+        pending |= todo[i];
+      }
+    }
+  }
+
+  void clearPage(uint8_t page) {
+    uint8_t bit = 1 << page;
+    if (_clear && !(_donePages & bit)) {
+      _display.fillPages(bit, BLACK);
+      _donePages |= bit;
+    }
+  }
+
+  // clip to panel pages first..last, in the current rotation
+  void setBand(uint8_t first, uint8_t last) {
+    const int16_t rows = Display::PAGES * 8;
+    int16_t row = first * 8, height = (last - first + 1) * 8;
+    if (_display.getRotation() >= 2)
+      row = rows - row - height;
+    if (_display.getRotation() & 1)
+      _display.setClipRect(row, 0, height, _display.height());
+    else
+      _display.setClipRect(0, row, _display.width(), height);
+  }
+
+  void draw(const Command &c) {
+    const int16_t *a = c.a;
+    switch (c.op) {
+    case PIXEL:           _display.drawPixel(a[0], a[1], c.color); break;
+    case HLINE:           _display.drawFastHLine(a[0], a[1], a[2], c.color); break;
+    case VLINE:           _display.drawFastVLine(a[0], a[1], a[2], c.color); break;
+    case LINE:            _display.drawLine(a[0], a[1], a[2], a[3], c.color); break;
+    case RECT:            _display.drawRect(a[0], a[1], a[2], a[3], c.color); break;
+    case FILL_RECT:       _display.fillRect(a[0], a[1], a[2], a[3], c.color); break;
+    case CIRCLE:          _display.drawCircle(a[0], a[1], a[2], c.color); break;
+    case FILL_CIRCLE:     _display.fillCircle(a[0], a[1], a[2], c.color); break;
+    case ROUND_RECT:      _display.drawRoundRect(a[0], a[1], a[2], a[3], a[4], c.color); break;
+    case FILL_ROUND_RECT: _display.fillRoundRect(a[0], a[1], a[2], a[3], a[4], c.color); break;
+    case TRIANGLE:        _display.drawTriangle(a[0], a[1], a[2], a[3], a[4], a[5], c.color); break;
+    case FILL_TRIANGLE:   _display.fillTriangle(a[0], a[1], a[2], a[3], a[4], a[5], c.color); break;
+    case CHAR:            _display.drawChar(a[0], a[1], a[2], c.color, a[3], c.size); break;
+    case TEXT: {
+      const char *text = (const char *)c.data;
+      for (int16_t x=a[0]; *text; text++, x+=6*c.size) {
+        _display.drawChar(x, a[1], *text, c.color, a[2], c.size);
+      }
+      break;
+    }
+    case BITMAP:
+      _display.drawBitmap(a[0], a[1], (const uint8_t *)c.data, a[2], a[3], c.color);
+      break;
+    case SPRITE:
+      if (c.mask)
+        _display.drawSprite(a[0], a[1], (const uint8_t *)c.data, (const uint8_t *)c.mask, a[2], a[3]);
+      else
+        _display.drawSprite(a[0], a[1], (const uint8_t *)c.data, a[2], a[3], c.color);
+      break;
+    case COLUMNS:
+      _display.blitColumns(a[0], a[1], (const uint8_t *)c.data, a[2], c.color);
+      break;
+    }
+  }
+};
+
+#endif // _SSD1306_DISPLAYLIST_H
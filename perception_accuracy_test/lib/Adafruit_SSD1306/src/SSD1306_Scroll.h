@@ -0,0 +1,124 @@
+#ifndef _SSD1306_SCROLL_H
+#define _SSD1306_SCROLL_H
+
+/*********************************************************************
+Scrolling text for SSD1306 panels that moves the picture with the
+controller instead of resending it.
+
+SSD1306TextScroller scrolls a list of text lines up the whole screen one
+pixel row per step(). The panel's start line is advanced so everything
+already on screen moves for free, and only the single row that wraps
+from the top to the bottom is redrawn - usually a handful of bytes.
+
+SSD1306Ticker draws one line of text (up to the panel width) and leaves
+the controller's horizontal scroll to rotate it with no further traffic.
+
+Both draw in panel coordinates and expect rotation 0.
+*********************************************************************/
+
+#include "Adafruit_SSD1306.h"
+#include "glcdfont.h"
+
+template <class Display>
+class SSD1306TextScroller {
+ public:
+  SSD1306TextScroller(Display &display) : _display(display) {}
+
+  // show lines[0..count-1] from the top, blank lines pad the loop to one screen
+  void begin(const char * const *lines, uint8_t count) {
+    _lines = lines;
+    _count = count;
+    _period = (count + 1 > _display.height() / 8) ? count + 1 : _display.height() / 8;
+    _offset = 0;
+    _display.setStartLine(0);
+    for (int16_t row=0; row<_display.height(); row++) {
+      renderRow(row);
+    }
+    _display.display();
+  }
+
+  // scroll up one row: send the row that wraps round into the RAM row leaving the
+  // top, then move the start line, so the old top row never shows at the bottom
+  void step(void) {
+    uint32_t row = _offset + _display.height();
+    renderRow(row);
+    _display.display();
+    _offset++;
+    _display.setStartLine(_offset % _display.height());
+  }
+
+  // back to normal addressing, the caller redraws the screen
+  void end(void) {
+    _display.setStartLine(0);
+    _display.clearDisplay();
+    _display.invalidate();
+  }
+
+  // text line currently at the top of the screen
+  uint8_t topLine(void) {
+    return (_offset / 8) % _period;
+  }
+
+ private:
+  Display &_display;
+  const char * const *_lines;
+  uint8_t _count;
+  uint16_t _period;   // count + 1 can be 256
+  uint32_t _offset;   // content row shown at the top of the panel
+
+  // content row 'row' lives in RAM row row % height, one bit of each column byte
+  void renderRow(uint32_t row) {
+    uint8_t line = (row / 8) % _period;
+    uint8_t bit = row % 8;
+    int16_t y = row % _display.height();
+    const char *text = (line < _count) ? _lines[line] : "";
+
+    for (int16_t x=0; x<_display.width(); x++) {
+      uint8_t column = 0;
+      if (*text) {
+        uint8_t c = x % 6;
+        if (c < 5)
+          column = glcdfont[(uint8_t)*text * 5 + c];
+        if (c == 5)
+          text++;
+      }
+      // drawPixel only marks the byte dirty when the bit actually changes
+      _display.drawPixel(x, y, (column >> bit) & 1 ? WHITE : BLACK);
+    }
+  }
+};
+
+template <class Display>
+class SSD1306Ticker {
+ public:
+  SSD1306Ticker(Display &display) : _display(display), _running(false) {}
+
+  // draw text on text row 'page' (y = page * 8) and let the controller scroll it
+  void begin(uint8_t page, const char *text, bool left = true) {
+    end();
+    _display.fillRect(0, page * 8, _display.width(), 8, BLACK);
+    _display.setCursor(0, page * 8);
+    _display.print(text);
+    _display.display();
+    if (left)
+      _display.startscrollleft(page, page);
+    else
+      _display.startscrollright(page, page);
+    _running = true;
+  }
+
+  // stop scrolling and put the unscrolled buffer back on the panel
+  void end(void) {
+    if (!_running)
+      return;
+    _display.stopscroll();
+    _display.display();
+    _running = false;
+  }
+
+ private:
+  Display &_display;
+  bool _running;
+};
+
+#endif // _SSD1306_SCROLL_H
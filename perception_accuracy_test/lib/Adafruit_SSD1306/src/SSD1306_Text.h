@@ -0,0 +1,39 @@
+#ifndef _SSD1306_TEXT_H
+#define _SSD1306_TEXT_H
+
+/*********************************************************************
+Text rasterized by the compiler. rasterizeText() turns a string literal
+into the page bytes print() would have produced with the 5x8 font at
+size 1, six columns per character, and a constexpr result lives in flash:
+
+  constexpr auto PUSH_TO_BEGIN = rasterizeText("PUSH BUTTON TO BEGIN.");
+  display.blitText(1, 52, PUSH_TO_BEGIN);
+
+blitText() only copies the columns into the buffer, no formatting or
+per-character work happens at run time. It matches print() while the
+line fits; past the right edge it is clipped, where print() would wrap
+the last characters onto the next line.
+*********************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "glcdfont.h"
+
+template <size_t N>
+struct SSD1306Text {
+  static const uint16_t WIDTH = (N - 1) * 6;
+  uint8_t columns[WIDTH];
+};
+
+template <size_t N>
+constexpr SSD1306Text<N> rasterizeText(const char (&text)[N]) {
+  SSD1306Text<N> out = {};
+  for (size_t i=0; i<N-1; i++) {
+    for (uint8_t c=0; c<6; c++) {
+      out.columns[i*6 + c] = (c < 5) ? glcdfont[(uint8_t)text[i]*5 + c] : 0;
+    }
+  }
+  return out;
+}
+
+#endif // _SSD1306_TEXT_H
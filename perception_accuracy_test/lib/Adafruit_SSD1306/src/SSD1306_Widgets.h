@@ -0,0 +1,260 @@
+#ifndef _SSD1306_WIDGETS_H
+#define _SSD1306_WIDGETS_H
+
+/*********************************************************************
+Retained widgets for SSD1306 screens. Each widget remembers the box it
+last drew; setting a new value only marks it dirty. SSD1306Screen::update()
+clears the old boxes of dirty widgets, redraws them, repairs any widget that
+overlapped what was cleared by redrawing it clipped to the cleared box, and
+leaves everything else alone, so the driver's dirty tracking sends just
+those columns:
+
+  SSD1306Screen<Adafruit_SSD1306> screen(display);
+  SSD1306Number<Adafruit_SSD1306> temp(36, 26, "%i F", 2);
+  screen.add(&temp);
+  screen.begin();                 // draws everything once
+  temp.set(72);
+  if (screen.update())            // false when nothing changed
+    display.display();
+
+Widgets draw in the display's current rotation, text in WHITE at their own
+size; the display's text size and colors are left as they were. update()
+leaves the clip rectangle reset to the whole screen.
+
+Old boxes are erased with fillRect(BLACK), which also wipes anything drawn
+under them that is not a widget, e.g. text blitted or restored from a layer.
+Keep static content outside the widgets' boxes, or restore it before update().
+*********************************************************************/
+
+#include "Adafruit_SSD1306.h"
+
+#define SSD1306_MAX_WIDGETS 8
+#define SSD1306_NUMBER_CHARS 12
+
+template <class Display>
+class SSD1306Widget {
+ public:
+  SSD1306Widget() : _dirty(true), _drawn(false) {}
+  virtual ~SSD1306Widget() {}
+
+  bool dirty(void) { return _dirty; }
+  void invalidate(void) { _dirty = true; }
+
+  // draw and record the bounding box in x, y, w, h
+  virtual void draw(Display &display) = 0;
+
+  bool intersects(int16_t bx, int16_t by, int16_t bw, int16_t bh) {
+    return _drawn && x < bx + bw && bx < x + w && y < by + bh && by < y + h;
+  }
+
+  int16_t x, y, w, h;   // box of what is on screen, valid once drawn
+
+ protected:
+  bool _dirty, _drawn;
+  template <class> friend class SSD1306Screen;
+};
+
+// fixed or occasionally changed text, e.g. a game mode name
+template <class Display>
+class SSD1306Label : public SSD1306Widget<Display> {
+ public:
+  SSD1306Label(int16_t left, int16_t top, const char *text, uint8_t size = 1)
+    : _left(left), _top(top), _text(text), _size(size) {}
+
+  // a different string (compared by pointer) or position
+  void set(const char *text, int16_t left, int16_t top) {
+    if (text == _text && left == _left && top == _top)
+      return;
+    _text = text;
+    _left = left;
+    _top = top;
+    this->invalidate();
+  }
+  void set(const char *text) { set(text, _left, _top); }
+
+  void draw(Display &display) {
+    uint8_t size = display.getTextSize();
+    uint16_t color = display.getTextColor(), background = display.getTextBackground();
+    display.setTextSize(_size);
+    display.setTextColor(WHITE);
+    display.setCursor(_left, _top);
+    display.print(_text);
+    display.setTextSize(size);
+    display.setTextColor(color, background);
+    this->x = _left;
+    this->y = _top;
+    this->w = strlen(_text) * 6 * _size;
+    this->h = 8 * _size;
+  }
+
+ private:
+  int16_t _left, _top;
+  const char *_text;
+  uint8_t _size;
+};
+
+// one integer through a printf format, redrawn only when the value changes
+template <class Display>
+class SSD1306Number : public SSD1306Widget<Display> {
+ public:
+  SSD1306Number(int16_t left, int16_t top, const char *format, uint8_t size = 1)
+    : _left(left), _top(top), _format(format), _size(size), _value(0) {}
+
+  void set(int value) {
+    if (value == _value && this->_drawn)
+      return;
+    _value = value;
+    this->invalidate();
+  }
+  int value(void) { return _value; }
+
+  void draw(Display &display) {
+    char text[SSD1306_NUMBER_CHARS];
+    snprintf(text, sizeof(text), _format, _value);
+    uint8_t size = display.getTextSize();
+    uint16_t color = display.getTextColor(), background = display.getTextBackground();
+    display.setTextSize(_size);
+    display.setTextColor(WHITE);
+    display.setCursor(_left, _top);
+    display.print(text);
+    display.setTextSize(size);
+    display.setTextColor(color, background);
+    this->x = _left;
+    this->y = _top;
+    this->w = strlen(text) * 6 * _size;
+    this->h = 8 * _size;
+  }
+
+ private:
+  int16_t _left, _top;
+  const char *_format;
+  uint8_t _size;
+  int _value;
+};
+
+template <class Display>
+class SSD1306LineWidget : public SSD1306Widget<Display> {
+ public:
+  SSD1306LineWidget() : _x0(0), _y0(0), _x1(0), _y1(0) {}
+
+  void set(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (x0 == _x0 && y0 == _y0 && x1 == _x1 && y1 == _y1 && this->_drawn)
+      return;
+    _x0 = x0;
+    _y0 = y0;
+    _x1 = x1;
+    _y1 = y1;
+    this->invalidate();
+  }
+
+  void draw(Display &display) {
+    display.drawLine(_x0, _y0, _x1, _y1, WHITE);
+    this->x = (_x0 < _x1) ? _x0 : _x1;
+    this->y = (_y0 < _y1) ? _y0 : _y1;
+    this->w = abs(_x1 - _x0) + 1;
+    this->h = abs(_y1 - _y0) + 1;
+  }
+
+ private:
+  int16_t _x0, _y0, _x1, _y1;
+};
+
+// outlined horizontal bar filled to value / maximum, empty when maximum <= 0
+template <class Display>
+class SSD1306Gauge : public SSD1306Widget<Display> {
+ public:
+  SSD1306Gauge(int16_t left, int16_t top, int16_t width, int16_t height, int maximum)
+    : _left(left), _top(top), _width(width), _height(height), _maximum(maximum), _fill(0) {}
+
+  void set(int value) {
+    if (value < 0) value = 0;
+    if (value > _maximum) value = _maximum;
+    int16_t fill = (_maximum > 0) ? (int32_t)(_width - 2) * value / _maximum : 0;
+    if (fill == _fill && this->_drawn)
+      return;
+    _fill = fill;
+    this->invalidate();
+  }
+
+  void draw(Display &display) {
+    display.drawRect(_left, _top, _width, _height, WHITE);
+    display.fillRect(_left + 1, _top + 1, _fill, _height - 2, WHITE);
+    this->x = _left;
+    this->y = _top;
+    this->w = _width;
+    this->h = _height;
+  }
+
+ private:
+  int16_t _left, _top, _width, _height;
+  int _maximum;
+  int16_t _fill;
+};
+
+template <class Display>
+class SSD1306Screen {
+ public:
+  SSD1306Screen(Display &display) : _display(display), _count(0) {}
+
+  bool add(SSD1306Widget<Display> *widget) {
+    if (_count >= SSD1306_MAX_WIDGETS)
+      return false;
+    _widget[_count++] = widget;
+    return true;
+  }
+
+  // draw every widget over whatever is in the buffer, e.g. a restored layer
+  void begin(void) {
+    for (uint8_t i=0; i<_count; i++) {
+      _widget[i]->_drawn = false;
+      _widget[i]->invalidate();
+    }
+    update();
+  }
+
+  // redraw what changed, returns false when the buffer was not touched
+  bool update(void) {
+    int16_t box[SSD1306_MAX_WIDGETS][4];   // erased x, y, w, h
+    uint8_t erased = 0;
+    bool changed = false;
+    // erase old boxes, widgets drawn under them are put back below, other content is not
+    for (uint8_t i=0; i<_count; i++) {
+      SSD1306Widget<Display> *widget = _widget[i];
+      if (!widget->_dirty || !widget->_drawn)
+        continue;
+      _display.fillRect(widget->x, widget->y, widget->w, widget->h, BLACK);
+      box[erased][0] = widget->x;
+      box[erased][1] = widget->y;
+      box[erased][2] = widget->w;
+      box[erased][3] = widget->h;
+      erased++;
+    }
+    for (uint8_t i=0; i<_count; i++) {
+      SSD1306Widget<Display> *widget = _widget[i];
+      if (widget->_dirty) {
+        widget->draw(_display);
+        widget->_drawn = true;
+        widget->_dirty = false;
+        changed = true;
+        continue;
+      }
+      // unchanged, only the parts under erased boxes need drawing again
+      for (uint8_t j=0; j<erased; j++) {
+        if (!widget->intersects(box[j][0], box[j][1], box[j][2], box[j][3]))
+          continue;
+        _display.setClipRect(box[j][0], box[j][1], box[j][2], box[j][3]);
+        widget->draw(_display);
+        _display.resetClipRect();
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+ private:
+  Display &_display;
+  SSD1306Widget<Display> *_widget[SSD1306_MAX_WIDGETS];
+  uint8_t _count;
+};
+
+#endif // _SSD1306_WIDGETS_H
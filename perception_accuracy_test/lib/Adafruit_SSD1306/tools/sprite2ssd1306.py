@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Convert a PBM or PNG image into an SSD1306 page-format sprite header.
+
+The output is what Adafruit_SSD1306::drawSprite() expects: ceil(h/8) pages
+of w bytes, one byte per column, top row of each page in bit 0.
+
+  python3 sprite2ssd1306.py logo.png -o ../../../src/logo.h
+  python3 sprite2ssd1306.py cursor.png --name CURSOR --mask
+
+Dark pixels become set bits (PBM 1 is dark), --invert swaps that. With
+--mask a second array marks which pixels are opaque, taken from the PNG
+alpha channel (fully opaque when the image has none).
+
+Only the standard library is used. PNG support covers non-interlaced
+grayscale, RGB, palette and alpha images at any bit depth up to 8.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+def read_pbm(data):
+    """Return (width, height, pixels) with pixels[y][x] = (dark, opaque)."""
+    # header tokens, skipping comments
+    tokens = []
+    pos = 2
+    while len(tokens) < 2:
+        match = re.compile(rb"\s*(#[^\n]*\n|\S+)").match(data, pos)
+        if match is None:
+            raise ValueError("truncated PBM header")
+        pos = match.end()
+        if not match.group(1).startswith(b"#"):
+            tokens.append(int(match.group(1)))
+    width, height = tokens
+    if data[:2] == b"P1":
+        bits = [c == ord("1") for c in data[pos:] if c in b"01"]
+    else:
+        raster = data[pos + 1:]
+        stride = (width + 7) // 8
+        bits = []
+        for y in range(height):
+            row = raster[y * stride:(y + 1) * stride]
+            bits.extend(bool(row[x // 8] & (0x80 >> (x % 8))) for x in range(width))
+    if len(bits) < width * height:
+        raise ValueError("truncated PBM raster")
+    return width, height, [[(bits[y * width + x], True) for x in range(width)] for y in range(height)]
+
+
+def read_png(data):
+    """Return (width, height, pixels) with pixels[y][x] = (dark, opaque)."""
+    pos = 8
+    palette, alpha, idat = None, None, b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            alpha = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("interlaced PNG is not supported")
+    if depth > 8:
+        raise ValueError("16-bit PNG is not supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        filt = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filt == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filt == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filt == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif filt == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    scale = 255 // ((1 << depth) - 1)
+
+    def sample(line, index):
+        bit = index * depth
+        return (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+
+    pixels = []
+    for line in rows:
+        out = []
+        for x in range(width):
+            values = [sample(line, x * channels + k) for k in range(channels)]
+            opaque = True
+            if ctype == 3:
+                index = values[0]
+                r, g, b = palette[index]
+                if alpha is not None and index < len(alpha):
+                    opaque = alpha[index] >= 128
+            elif ctype in (0, 4):
+                r = g = b = values[0] * scale
+                if ctype == 4:
+                    opaque = values[1] * scale >= 128
+            else:
+                r, g, b = (v * scale for v in values[:3])
+                if ctype == 6:
+                    opaque = values[3] * scale >= 128
+            out.append(((r * 299 + g * 587 + b * 114) // 1000 < 128, opaque))
+        pixels.append(out)
+    return width, height, pixels
+
+
+def pack(width, height, pixels, select):
+    """Page format: for each 8 rows, one byte per column with the top row in bit 0."""
+    out = []
+    for top in range(0, height, 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(min(8, height - top)):
+                if select(pixels[top + bit][x]):
+                    byte |= 1 << bit
+            out.append(byte)
+    return out
+
+
+def c_array(name, values):
+    lines = []
+    for i in range(0, len(values), 16):
+        lines.append("  " + ", ".join("0x%02X" % v for v in values[i:i + 16]) + ",")
+    return "const uint8_t %s[] = {\n%s\n};\n" % (name, "\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="PBM (P1/P4) or PNG file")
+    parser.add_argument("-o", "--output", help="header to write (default: stdout)")
+    parser.add_argument("--name", help="array name (default: from the file name)")
+    parser.add_argument("--invert", action="store_true", help="light pixels become set bits")
+    parser.add_argument("--mask", action="store_true", help="also emit NAME_MASK from transparency")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+    if data[:2] in (b"P1", b"P4"):
+        width, height, pixels = read_pbm(data)
+    elif data[:8] == b"\x89PNG\r\n\x1a\n":
+        width, height, pixels = read_png(data)
+    else:
+        sys.exit("%s: not a PBM or PNG image" % args.image)
+
+    base = os.path.splitext(os.path.basename(args.image))[0]
+    name = args.name or re.sub(r"\W", "_", base).upper()
+    guard = "_%s_H" % name
+
+    header = "// %s, %dx%d, generated by sprite2ssd1306.py - do not edit\n" % (os.path.basename(args.image), width, height)
+    header += "#ifndef %s\n#define %s\n\n" % (guard, guard)
+    header += "const int16_t %s_WIDTH = %d;\nconst int16_t %s_HEIGHT = %d;\n\n" % (name, width, name, height)
+    header += c_array(name, pack(width, height, pixels, lambda p: p[1] and (p[0] != args.invert)))
+    if args.mask:
+        header += "\n" + c_array(name + "_MASK", pack(width, height, pixels, lambda p: p[1]))
+    header += "\n#endif // %s\n" % guard
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+
+
+if __name__ == "__main__":
+    main()
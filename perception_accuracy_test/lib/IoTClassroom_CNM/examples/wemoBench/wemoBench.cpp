@@ -0,0 +1,79 @@
+/*
+ * Project wemoBench
+ * Description: Outlet-control benchmark for wemo.h against the wemoMock example
+ * Date: 19-OCT-2026
+ * Points the wemo.h outlet table at a device running examples/wemoMock and drives the
+ * wemoWriteConfirmed() path, reporting toggles/sec and round-trip percentiles (request
+ * sent to HTTP response parsed, so the mock's latency and drops are included) for a
+ * single-outlet and a round-robin multi-outlet workload. Port hops on the mock are
+ * picked up through wemoDiscoveryLoop() just as they would be in the classroom. The
+ * mock addresses are pinned for this session only and never written to EEPROM.
+ */
+
+// Include Particle Device OS APIs
+#include "Particle.h"
+#include "IoTClassroom_CNM.h"
+
+SYSTEM_MODE(MANUAL); //control logging into classroom router
+
+const IPAddress MOCKIP(192,168,1,60);  // address of the device running wemoMock
+const int MOCKOUTLETS = 2;
+const int TOGGLES = 200;
+
+unsigned int latency[TOGGLES];
+
+void runWorkload(const char *name, int outlets);
+int compareLatency(const void *a, const void *b);
+
+void setup() {
+  Serial.begin(9600);
+  waitFor(Serial.isConnected,15000);
+
+  WiFi.on();
+  WiFi.clearCredentials();
+  WiFi.setCredentials("IoTNetwork");
+
+  WiFi.connect();
+  while(WiFi.connecting()) {
+    Serial.printf(".");
+  }
+  Serial.printf("\n\n");
+
+  for (int i=0; i<MOCKOUTLETS; i++) {
+    char udn[WEMO_UDN_LEN];
+    snprintf(udn, sizeof(udn), "uuid:Socket-1_0-MOCK%04i", i);
+    wemoSetAddress(i, MOCKIP, 49152 + i, udn);
+  }
+}
+
+void loop() {
+  runWorkload("single outlet", 1);
+  runWorkload("multi outlet", MOCKOUTLETS);
+  delay(10000);
+}
+
+void runWorkload(const char *name, int outlets) {
+  int failures = 0;
+  unsigned int start = millis();
+
+  for (int i=0; i<TOGGLES; i++) {
+    int wemo = i % outlets;
+    unsigned int t0 = micros();
+    if (!wemoWriteConfirmed(wemo, (i / outlets) & 1)) {
+      failures++;
+    }
+    latency[i] = micros() - t0;
+    wemoDiscoveryLoop();
+  }
+
+  unsigned int elapsed = millis() - start;
+  qsort(latency, TOGGLES, sizeof(latency[0]), compareLatency);
+  Serial.printf("%s: %i toggles in %ums, %0.1f toggles/sec, %i failed\n", name, TOGGLES, elapsed, TOGGLES * 1000.0 / elapsed, failures);
+  Serial.printf("  round trip us: p50 %u, p90 %u, p99 %u, max %u\n", latency[TOGGLES / 2], latency[TOGGLES * 9 / 10], latency[TOGGLES * 99 / 100], latency[TOGGLES - 1]);
+}
+
+int compareLatency(const void *a, const void *b) {
+  unsigned int x = *(const unsigned int *)a;
+  unsigned int y = *(const unsigned int *)b;
+  return (x > y) - (x < y);
+}
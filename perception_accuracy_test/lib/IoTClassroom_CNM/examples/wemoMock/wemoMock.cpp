@@ -0,0 +1,248 @@
+/*
+ * Project wemoMock
+ * Description: Stand-in Wemo outlet(s) for testing and benchmarking wemo.h off the classroom network
+ * Date: 19-OCT-2026
+ * Flash this to a spare Particle device on the same network as the device under test
+ * (see examples/wemoBench). It answers SSDP searches and implements the basicevent1
+ * SetBinaryState/GetBinaryState (and Insight GetInsightParams) SOAP actions for
+ * MOCKOUTLETS virtual outlets, with configurable response latency, port hopping
+ * and dropped connections.
+ *
+ * Serial keys: l = cycle latency, h = hop ports now, d = cycle drop rate, s = print state
+ */
+
+// Include Particle Device OS APIs
+#include "Particle.h"
+
+SYSTEM_MODE(MANUAL); //control logging into classroom router
+
+const int MOCKOUTLETS = 2;
+const uint16_t FIRSTPORT = 49152;      // Wemo outlets use 49152-49155
+const int PORTCOUNT = 4;
+const unsigned int HOPINTERVAL = 60000; // ms between port hops, 0 = never hop
+const int LATENCIES[] = {0, 20, 100, 500}; // ms added before each response
+const int DROPRATES[] = {0, 5, 25};        // percent of connections closed without a response
+const int REQUESTMAX = 1024;
+
+struct MockOutlet {
+  TCPServer *server;
+  TCPClient client;
+  uint16_t port;
+  bool state;
+  char request[REQUESTMAX];
+  int requestLen;
+  unsigned int respondAt;
+  bool responding;
+  int requests, drops;
+};
+
+MockOutlet outlet[MOCKOUTLETS];
+UDP ssdp;
+int hop = 0;
+int latencyIndex = 0;
+int dropIndex = 0;
+unsigned int lastHop;
+char packet[512];
+
+void openOutlet(int i);
+void pollOutlet(int i);
+void respond(int i);
+void pollSSDP();
+void printState();
+
+void setup() {
+  Serial.begin(9600);
+  waitFor(Serial.isConnected,15000);
+
+  WiFi.on();
+  WiFi.clearCredentials();
+  WiFi.setCredentials("IoTNetwork");
+
+  WiFi.connect();
+  while(WiFi.connecting()) {
+    Serial.printf(".");
+  }
+  Serial.printf("\n\n");
+
+  for (int i=0; i<MOCKOUTLETS; i++) {
+    outlet[i].server = NULL;
+    openOutlet(i);
+  }
+  ssdp.begin(1900);
+  ssdp.joinMulticast(IPAddress(239,255,255,250));
+  lastHop = millis();
+  printState();
+}
+
+void loop() {
+  if (Serial.available()) {
+    switch (Serial.read()) {
+      case 'l':
+        latencyIndex = (latencyIndex + 1) % (sizeof(LATENCIES) / sizeof(LATENCIES[0]));
+        break;
+      case 'h':
+        lastHop = millis() - HOPINTERVAL;
+        break;
+      case 'd':
+        dropIndex = (dropIndex + 1) % (sizeof(DROPRATES) / sizeof(DROPRATES[0]));
+        break;
+      default:
+        break;
+    }
+    printState();
+  }
+
+  if ((HOPINTERVAL > 0) && ((millis() - lastHop) >= HOPINTERVAL)) {
+    hop++;
+    for (int i=0; i<MOCKOUTLETS; i++) {
+      openOutlet(i);
+    }
+    lastHop = millis();
+    printState();
+  }
+
+  pollSSDP();
+  for (int i=0; i<MOCKOUTLETS; i++) {
+    pollOutlet(i);
+  }
+}
+
+// (re)open the listening socket on the outlet's current port
+void openOutlet(int i) {
+  MockOutlet &o = outlet[i];
+  if (o.server != NULL) {
+    o.client.stop();
+    o.server->stop();
+    delete o.server;
+  }
+  o.port = FIRSTPORT + ((i + hop) % PORTCOUNT);
+  o.server = new TCPServer(o.port);
+  o.server->begin();
+  o.requestLen = 0;
+  o.responding = false;
+}
+
+void pollOutlet(int i) {
+  MockOutlet &o = outlet[i];
+
+  if (!o.client.connected()) {
+    o.client = o.server->available();
+    o.requestLen = 0;
+    o.responding = false;
+    if (!o.client.connected()) {
+      return;
+    }
+    if (random(100) < DROPRATES[dropIndex]) {
+      o.drops++;
+      o.client.stop();
+      return;
+    }
+  }
+
+  while (o.client.available() && (o.requestLen < REQUESTMAX - 1)) {
+    o.request[o.requestLen++] = o.client.read();
+  }
+  o.request[o.requestLen] = '\0';
+
+  // a request is complete once the headers and Content-Length bytes of body are in
+  if (!o.responding) {
+    char *body = strstr(o.request, "\r\n\r\n");
+    char *length = strstr(o.request, "Content-Length:");
+    if (body == NULL || length == NULL) {
+      return;
+    }
+    body += 4;
+    if ((o.request + o.requestLen) - body < atoi(length + 15)) {
+      return;
+    }
+    o.responding = true;
+    o.respondAt = millis() + LATENCIES[latencyIndex];
+  }
+
+  if (o.responding && ((int)(millis() - o.respondAt) >= 0)) {
+    respond(i);
+  }
+}
+
+void respond(int i) {
+  MockOutlet &o = outlet[i];
+  char body[400];
+  const char *action;
+
+  o.requests++;
+  if (strstr(o.request, "#SetBinaryState") != NULL) {
+    char *state = strstr(o.request, "<BinaryState>");
+    if (state != NULL) {
+      o.state = (state[13] == '1');
+    }
+    action = "SetBinaryState";
+  }
+  else if (strstr(o.request, "#GetBinaryState") != NULL) {
+    action = "GetBinaryState";
+  }
+  else if (strstr(o.request, "#GetInsightParams") != NULL) {
+    // instantaneous power (mW) wanders around 60W while on, for the Insight sampler
+    snprintf(body, sizeof(body),
+      "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+      "<u:GetInsightParamsResponse xmlns:u=\"urn:Belkin:service:insight:1\">\n"
+      "<InsightParams>%i|0|0|0|0|1209600|0|%i|0|0.000000|8000</InsightParams>\n"
+      "</u:GetInsightParamsResponse>\n"
+      "</s:Body> </s:Envelope>",
+      o.state, o.state ? (int)random(55000, 65000) : 0);
+    action = NULL;
+  }
+  else {
+    o.client.print("HTTP/1.0 500 Internal Server Error\r\nCONTENT-LENGTH: 0\r\n\r\n");
+    o.client.stop();
+    return;
+  }
+
+  if (action != NULL) {
+    snprintf(body, sizeof(body),
+      "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+      "<u:%sResponse xmlns:u=\"urn:Belkin:service:basicevent:1\">\n"
+      "<BinaryState>%i</BinaryState>\n"
+      "</u:%sResponse>\n"
+      "</s:Body> </s:Envelope>",
+      action, o.state, action);
+  }
+
+  o.client.printf("HTTP/1.0 200 OK\r\nCONTENT-LENGTH: %i\r\nCONTENT-TYPE: text/xml; charset=\"utf-8\"\r\nEXT:\r\nSERVER: Unspecified, UPnP/1.0, Unspecified\r\n\r\n", (int)strlen(body));
+  o.client.print(body);
+  o.client.stop();
+  o.requestLen = 0;
+  o.responding = false;
+}
+
+// answer M-SEARCH for the basicevent service with each outlet's current port
+void pollSSDP() {
+  if (ssdp.parsePacket() <= 0) {
+    return;
+  }
+  int len = ssdp.read((uint8_t *)packet, sizeof(packet) - 1);
+  packet[len > 0 ? len : 0] = '\0';
+  if (strstr(packet, "M-SEARCH") == NULL) {
+    return;
+  }
+
+  IPAddress me = WiFi.localIP();
+  IPAddress them = ssdp.remoteIP();
+  uint16_t themPort = ssdp.remotePort();
+  for (int i=0; i<MOCKOUTLETS; i++) {
+    ssdp.beginPacket(them, themPort);
+    ssdp.printf("HTTP/1.1 200 OK\r\n");
+    ssdp.printf("CACHE-CONTROL: max-age=86400\r\n");
+    ssdp.printf("LOCATION: http://%i.%i.%i.%i:%i/setup.xml\r\n", me[0], me[1], me[2], me[3], outlet[i].port);
+    ssdp.printf("ST: urn:Belkin:service:basicevent:1\r\n");
+    ssdp.printf("USN: uuid:Socket-1_0-MOCK%04i::urn:Belkin:service:basicevent:1\r\n", i);
+    ssdp.printf("\r\n");
+    ssdp.endPacket();
+  }
+}
+
+void printState() {
+  Serial.printf("latency %ims, drop %i%%, hop %i\n", LATENCIES[latencyIndex], DROPRATES[dropIndex], hop);
+  for (int i=0; i<MOCKOUTLETS; i++) {
+    Serial.printf("  outlet %i: port %i, state %i, requests %i, drops %i\n", i, outlet[i].port, outlet[i].state, outlet[i].requests, outlet[i].drops);
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * Project wemoXmlBench
+ * Description: Benchmark of the wemoXml.h pull parser on recorded Wemo responses
+ * Date: 19-OCT-2026
+ * No network needed. Each recorded payload is fed through WemoXmlReader a byte at a
+ * time (as it would arrive from WemoClient) and, for comparison, buffered into a String
+ * and searched with indexOf(). Prints microseconds per response and parser throughput.
+ */
+
+// Include Particle Device OS APIs
+#include "Particle.h"
+#include "IoTClassroom_CNM.h"
+
+SYSTEM_MODE(MANUAL);
+
+const int RUNS = 1000;
+
+struct Payload {
+  const char *name;
+  const char *element;
+  const char *text;
+};
+
+// representative responses, laid out the way the outlets send them
+const Payload payloads[] = {
+  {"SetBinaryState", "BinaryState",
+    "HTTP/1.0 200 OK\r\nCONTENT-LENGTH: 371\r\nCONTENT-TYPE: text/xml; charset=\"utf-8\"\r\nDATE: Mon, 03 Mar 2025 18:04:11 GMT\r\nEXT:\r\nSERVER: Unspecified, UPnP/1.0, Unspecified\r\nX-User-Agent: redsonic\r\n\r\n"
+    "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+    "<u:SetBinaryStateResponse xmlns:u=\"urn:Belkin:service:basicevent:1\">\n"
+    "<BinaryState>1</BinaryState>\n"
+    "<CountdownEndTime>0</CountdownEndTime>\n"
+    "<deviceCurrentTime>1741025051</deviceCurrentTime>\n"
+    "</u:SetBinaryStateResponse>\n"
+    "</s:Body> </s:Envelope>"},
+  {"GetBinaryState", "BinaryState",
+    "HTTP/1.0 200 OK\r\nCONTENT-LENGTH: 309\r\nCONTENT-TYPE: text/xml; charset=\"utf-8\"\r\nDATE: Mon, 03 Mar 2025 18:04:12 GMT\r\nEXT:\r\nSERVER: Unspecified, UPnP/1.0, Unspecified\r\nX-User-Agent: redsonic\r\n\r\n"
+    "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+    "<u:GetBinaryStateResponse xmlns:u=\"urn:Belkin:service:basicevent:1\">\n"
+    "<BinaryState>8|1741024890|0|0|0|0|0|0|0|0</BinaryState>\n"
+    "</u:GetBinaryStateResponse>\n"
+    "</s:Body> </s:Envelope>"},
+  {"GetInsightParams", "InsightParams",
+    "HTTP/1.0 200 OK\r\nCONTENT-LENGTH: 359\r\nCONTENT-TYPE: text/xml; charset=\"utf-8\"\r\nDATE: Mon, 03 Mar 2025 18:04:13 GMT\r\nEXT:\r\nSERVER: Unspecified, UPnP/1.0, Unspecified\r\nX-User-Agent: redsonic\r\n\r\n"
+    "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+    "<u:GetInsightParamsResponse xmlns:u=\"urn:Belkin:service:insight:1\">\n"
+    "<InsightParams>1|1741024890|161|1187|96512|1209600|33|61330|1245117|48721440.000000|8000</InsightParams>\n"
+    "</u:GetInsightParamsResponse>\n"
+    "</s:Body> </s:Envelope>"},
+  {"SOAP fault", "errorCode",
+    "HTTP/1.0 500 Internal Server Error\r\nCONTENT-LENGTH: 409\r\nCONTENT-TYPE: text/xml; charset=\"utf-8\"\r\nEXT:\r\nSERVER: Unspecified, UPnP/1.0, Unspecified\r\nX-User-Agent: redsonic\r\n\r\n"
+    "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>\n"
+    "<s:Fault>\n<faultcode>s:Client</faultcode>\n<faultstring>UPnPError</faultstring>\n<detail>\n"
+    "<UPnPError xmlns=\"urn:schemas-upnp-org:control-1-0\">\n"
+    "<errorCode>-1</errorCode>\n<errorDescription>Invalid Action</errorDescription>\n"
+    "</UPnPError>\n</detail>\n</s:Fault>\n"
+    "</s:Body> </s:Envelope>"},
+};
+
+void benchPayload(const Payload &payload);
+
+void setup() {
+  Serial.begin(9600);
+  waitFor(Serial.isConnected,15000);
+}
+
+void loop() {
+  for (unsigned int i=0; i<sizeof(payloads)/sizeof(payloads[0]); i++) {
+    benchPayload(payloads[i]);
+  }
+  Serial.printf("\n");
+  delay(10000);
+}
+
+void benchPayload(const Payload &payload) {
+  int len = strlen(payload.text);
+  char found[WEMO_XML_VALUELEN] = "";
+  WemoXmlReader reader;
+
+  unsigned int start = micros();
+  for (int run=0; run<RUNS; run++) {
+    reader.begin();
+    for (int i=0; i<len; i++) {
+      if ((reader.feed(payload.text[i]) == WEMO_XML_ELEMENT) && (strcmp(reader.name(), payload.element) == 0)) {
+        strcpy(found, reader.value());
+      }
+    }
+  }
+  unsigned int pullTime = micros() - start;
+
+  // for comparison: buffer the whole response in a String, then search it
+  String value;
+  start = micros();
+  for (int run=0; run<RUNS; run++) {
+    String body;
+    for (int i=0; i<len; i++) {
+      body += payload.text[i];
+    }
+    String open = String("<") + payload.element + ">";
+    int from = body.indexOf(open);
+    int to = body.indexOf("</", from);
+    if (from >= 0 && to > from) {
+      value = body.substring(from + open.length(), to);
+    }
+  }
+  unsigned int stringTime = micros() - start;
+
+  Serial.printf("%-16s %4i bytes: pull %0.2f us (%0.1f bytes/us), String %0.2f us, %s=%s\n",
+    payload.name, len, (float)pullTime / RUNS, (float)len * RUNS / pullTime, (float)stringTime / RUNS, payload.element, found);
+}
@@ -1,6 +1,7 @@
 #include "Particle.h"
 #include "hue.h"
 #include "wemo.h"
+#include "wemoInsight.h"
 #include "IoTTimer.h"
 #include "Button.h"
 #include "Colors.h"
\ No newline at end of file
@@ -0,0 +1,411 @@
+#ifndef _NETSCHEDULER_H_
+#define _NETSCHEDULER_H_
+
+/*
+ *  Project: IoT Classroom Library
+ *  Description: Shared non-blocking scheduler for Hue and Wemo commands
+ *  Date:     19-OCT-2026
+ */
+
+#include "application.h"
+#include "hue.h"
+#include "wemo.h"
+
+/* Usage:
+ * #include "netScheduler.h"                                    // not part of IoTClassroom_CNM.h
+ * hueSubmit(lightNum, HueOn, HueColor, HueBright, HueSat);   // same arguments as setHue()
+ * wemoSubmit(outlet, wemoState);                               // same arguments as wemoWrite()
+ * netScheduler.poll();                                         // once per pass through any loop
+ *
+ * Commands are queued as jobs with a priority (higher runs first) and a deadline, after
+ * which a job that has not started is dropped. poll() moves every in-flight job one step
+ * along - connect, write the request, read the HTTP response as it arrives - over a pool
+ * of NET_SOCKETS TCPClients shared by both libraries, so Hue and Wemo traffic overlap.
+ * Sockets stay open after a response and are reused for the next job to the same host.
+ * TCPClient::connect() itself still blocks, so poll() opens at most one new connection.
+ *
+ * A queued command for a device is replaced by a newer one for the same device (the
+ * latest state wins), and only one command per device is in flight at a time so they
+ * still arrive in order. The blocking setHue()/wemoWrite() calls are unchanged.
+ *
+ * The job queue holds NET_MAX_JOBS requests of up to NET_REQUEST_LEN bytes, about 8 KB
+ * of static RAM, so the scheduler is only compiled into sketches that include it.
+ */
+
+const int NET_MAX_JOBS = 12;
+const int NET_SOCKETS = 3;
+const int NET_REQUEST_LEN = 640;
+const int NET_MAX_DEVICES = 16;
+const unsigned int NET_RESPONSE_MS = 2000;
+const unsigned int NET_DEADLINE_MS = 5000;
+
+// device kinds
+const uint8_t NET_HUE = 0;
+const uint8_t NET_WEMO = 1;
+
+// priorities
+const int NET_LOW = 0;
+const int NET_NORMAL = 1;
+const int NET_HIGH = 2;
+
+// fixed buffer a request is built into before it is queued
+class NetRequest : public Print {
+  public:
+    char data[NET_REQUEST_LEN];
+    int length;
+    bool overflow;
+
+    NetRequest() {
+      length = 0;
+      overflow = false;
+    }
+
+    virtual size_t write(uint8_t c) {
+      if (length >= NET_REQUEST_LEN) {
+        overflow = true;
+        return 0;
+      }
+      data[length++] = c;
+      return 1;
+    }
+    using Print::write;
+};
+
+class NetScheduler {
+  public:
+    struct DeviceStats {
+      uint8_t kind, index;
+      unsigned int completed, failed, expired;
+      unsigned int lastMs, maxMs;
+      float avgMs;  // moving average over roughly the last 8 commands
+    };
+
+  private:
+    enum JobState { FREE, QUEUED, ACTIVE };
+
+    struct Job {
+      JobState state;
+      uint8_t kind, index;
+      int priority;
+      uint32_t seq;
+      unsigned int submitted, deadline;
+      IPAddress ip;
+      uint16_t port;
+      char request[NET_REQUEST_LEN];
+      int length, sent;
+    };
+
+    struct Socket {
+      TCPClient client;
+      IPAddress ip;
+      uint16_t port;
+      int job;  // -1 when idle
+      unsigned int startedAt;
+      WemoXmlReader reader;
+    };
+
+    Job _job[NET_MAX_JOBS];
+    Socket _socket[NET_SOCKETS];
+    DeviceStats _stats[NET_MAX_DEVICES];
+    int _devices;
+    uint32_t _seq;
+    unsigned int _maxDepth;
+
+  public:
+    NetScheduler() {
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        _job[i].state = FREE;
+      }
+      for (int i=0; i<NET_SOCKETS; i++) {
+        _socket[i].job = -1;
+        _socket[i].port = 0;
+      }
+      _devices = 0;
+      _seq = 0;
+      _maxDepth = 0;
+    }
+
+    // queue a request, returns false if the queue is full or the request did not fit
+    bool submit(uint8_t kind, uint8_t index, IPAddress ip, uint16_t port, const NetRequest &request, int priority=NET_NORMAL, unsigned int deadlineMs=NET_DEADLINE_MS) {
+      if (request.overflow) {
+        return false;
+      }
+      int slot = -1;
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        if (_job[i].state == QUEUED && _job[i].kind == kind && _job[i].index == index) {
+          slot = i;  // supersede the pending command for this device
+          break;
+        }
+        if (slot < 0 && _job[i].state == FREE) {
+          slot = i;
+        }
+      }
+      if (slot < 0) {
+        return false;
+      }
+
+      Job &j = _job[slot];
+      bool replacing = (j.state == QUEUED);
+      j.state = QUEUED;
+      j.kind = kind;
+      j.index = index;
+      j.priority = priority;
+      j.deadline = millis() + deadlineMs;
+      if (!replacing) {
+        j.seq = _seq++;
+        j.submitted = millis();  // latency counts from the first command that was queued
+      }
+      j.ip = ip;
+      j.port = port;
+      memcpy(j.request, request.data, request.length);
+      j.length = request.length;
+      j.sent = 0;
+
+      unsigned int depth = queueDepth();
+      if (depth > _maxDepth) {
+        _maxDepth = depth;
+      }
+      return true;
+    }
+
+    // advance all in-flight jobs by one step and start queued ones on free sockets
+    void poll() {
+      unsigned int now = millis();
+
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        if (_job[i].state == QUEUED && (int)(now - _job[i].deadline) > 0) {
+          stats(_job[i].kind, _job[i].index).expired++;
+          _job[i].state = FREE;
+        }
+      }
+
+      for (int i=0; i<NET_SOCKETS; i++) {
+        if (_socket[i].job >= 0) {
+          advance(_socket[i]);
+        }
+      }
+
+      bool connected = false;  // only one blocking connect per poll
+      int next;
+      while ((next = nextJob()) >= 0) {
+        int s = pickSocket(_job[next]);
+        if (s < 0) {
+          break;
+        }
+        Socket &sock = _socket[s];
+        bool reuse = sock.client.connected() && (sock.ip == _job[next].ip) && (sock.port == _job[next].port);
+        if (!reuse) {
+          if (connected) {
+            break;
+          }
+          connected = true;
+          sock.client.stop();
+          sock.ip = _job[next].ip;
+          sock.port = _job[next].port;
+          if (!sock.client.connect(sock.ip, sock.port)) {
+            finish(next, false);
+            continue;
+          }
+        }
+        _job[next].state = ACTIVE;
+        sock.job = next;
+        sock.startedAt = millis();
+        sock.reader.begin();
+        advance(sock);
+      }
+    }
+
+    // true while anything is queued or in flight
+    bool busy() {
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        if (_job[i].state != FREE) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    unsigned int queueDepth() {
+      unsigned int depth = 0;
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        if (_job[i].state == QUEUED) {
+          depth++;
+        }
+      }
+      return depth;
+    }
+
+    unsigned int maxQueueDepth() {
+      return _maxDepth;
+    }
+
+    int deviceCount() {
+      return _devices;
+    }
+
+    const DeviceStats &deviceStats(int i) {
+      return _stats[i];
+    }
+
+    void printStats(Print &out) {
+      out.printf("net: queue %u (max %u)\n", queueDepth(), _maxDepth);
+      for (int i=0; i<_devices; i++) {
+        DeviceStats &d = _stats[i];
+        out.printf("  %s %i: %u ok, %u failed, %u expired, last %ums, avg %0.1fms, max %ums\n",
+          d.kind == NET_HUE ? "hue" : "wemo", d.index, d.completed, d.failed, d.expired, d.lastMs, d.avgMs, d.maxMs);
+      }
+    }
+
+  private:
+    DeviceStats &stats(uint8_t kind, uint8_t index) {
+      for (int i=0; i<_devices; i++) {
+        if (_stats[i].kind == kind && _stats[i].index == index) {
+          return _stats[i];
+        }
+      }
+      int i = (_devices < NET_MAX_DEVICES) ? _devices++ : NET_MAX_DEVICES - 1;
+      memset(&_stats[i], 0, sizeof(_stats[i]));
+      _stats[i].kind = kind;
+      _stats[i].index = index;
+      return _stats[i];
+    }
+
+    bool deviceActive(uint8_t kind, uint8_t index) {
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        if (_job[i].state == ACTIVE && _job[i].kind == kind && _job[i].index == index) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // highest priority first, then earliest deadline, then first come
+    int nextJob() {
+      int best = -1;
+      for (int i=0; i<NET_MAX_JOBS; i++) {
+        Job &j = _job[i];
+        if (j.state != QUEUED || deviceActive(j.kind, j.index)) {
+          continue;
+        }
+        if (best < 0) {
+          best = i;
+          continue;
+        }
+        Job &b = _job[best];
+        int dl = (int)(j.deadline - b.deadline);
+        if ((j.priority > b.priority) ||
+            (j.priority == b.priority && dl < 0) ||
+            (j.priority == b.priority && dl == 0 && (int)(j.seq - b.seq) < 0)) {
+          best = i;
+        }
+      }
+      return best;
+    }
+
+    // an idle socket already open to the job's host, else any idle socket
+    int pickSocket(Job &j) {
+      int idle = -1;
+      for (int i=0; i<NET_SOCKETS; i++) {
+        Socket &s = _socket[i];
+        if (s.job >= 0) {
+          continue;
+        }
+        if (s.client.connected() && s.ip == j.ip && s.port == j.port) {
+          return i;
+        }
+        if (idle < 0 || !s.client.connected()) {
+          idle = i;
+        }
+      }
+      return idle;
+    }
+
+    void advance(Socket &s) {
+      Job &j = _job[s.job];
+
+      if (j.sent < j.length) {
+        int n = s.client.write((const uint8_t *)j.request + j.sent, j.length - j.sent);
+        if (n > 0) {
+          j.sent += n;
+        }
+      }
+
+      int event = s.reader.next(s.client);
+      bool ok = (s.reader.status() >= 200) && (s.reader.status() < 300);
+      if (event == WEMO_XML_END) {
+        complete(s, ok);
+      }
+      else if (event == WEMO_XML_ERROR) {
+        s.client.stop();
+        complete(s, false);
+      }
+      else if (!s.client.connected()) {
+        complete(s, ok);  // server closed without a Content-Length
+      }
+      else if ((millis() - s.startedAt) >= NET_RESPONSE_MS) {
+        s.client.stop();
+        complete(s, ok);  // a chunked reply with no Content-Length only ends by timeout
+      }
+    }
+
+    void complete(Socket &s, bool ok) {
+      int job = s.job;
+      s.job = -1;
+      finish(job, ok);
+    }
+
+    void finish(int job, bool ok) {
+      Job &j = _job[job];
+      DeviceStats &d = stats(j.kind, j.index);
+      if (ok) {
+        d.lastMs = millis() - j.submitted;
+        if (d.lastMs > d.maxMs) {
+          d.maxMs = d.lastMs;
+        }
+        d.avgMs = d.completed ? d.avgMs + (d.lastMs - d.avgMs) / 8.0 : d.lastMs;
+        d.completed++;
+      }
+      else {
+        d.failed++;
+        if (j.kind == NET_WEMO) {
+          wemoMarkStale(j.index);
+        }
+      }
+      j.state = FREE;
+    }
+};
+
+NetScheduler netScheduler;
+
+// queue a Hue light change, arguments as for setHue()
+bool hueSubmit(int lightNum, bool HueOn, int HueColor=HueBlue, int HueBright=255, int HueSat=255, int priority=NET_NORMAL, unsigned int deadlineMs=NET_DEADLINE_MS) {
+  char body[64];
+  NetRequest request;
+  int a, b, c, d;
+
+  if (sscanf(hueHubIP, "%d.%d.%d.%d", &a, &b, &c, &d) != 4) {
+    return false;
+  }
+  if (HueOn) {
+    snprintf(body, sizeof(body), "{\"on\":true,\"sat\":%i,\"bri\":%i,\"hue\":%i}", HueSat, HueBright, HueColor);
+  }
+  else {
+    snprintf(body, sizeof(body), "{\"on\":false}");
+  }
+  request.printf("PUT /api/%s/lights/%i/state HTTP/1.1\r\n", hueUsername, lightNum);
+  request.printf("Host: %s\r\n", hueHubIP);
+  request.printf("Connection: keep-alive\r\n");
+  request.printf("Content-Type: text/plain;charset=UTF-8\r\n");
+  request.printf("Content-Length: %i\r\n\r\n", (int)strlen(body));
+  request.print(body);
+  return netScheduler.submit(NET_HUE, lightNum, IPAddress(a, b, c, d), hueHubPort, request, priority, deadlineMs);
+}
+
+// queue a Wemo outlet change, arguments as for wemoWrite()
+bool wemoSubmit(int outlet, bool wemoState, int priority=NET_NORMAL, unsigned int deadlineMs=NET_DEADLINE_MS) {
+  NetRequest request;
+  wemoSend(request, "basicevent", "SetBinaryState", wemoState ? "<BinaryState>1</BinaryState>" : "<BinaryState>0</BinaryState>", true);
+  return netScheduler.submit(NET_WEMO, outlet, wemoAddress(outlet), wemoOutletPort(outlet), request, priority, deadlineMs);
+}
+
+#endif // _NETSCHEDULER_H_
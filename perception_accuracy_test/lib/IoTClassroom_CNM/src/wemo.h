@@ -15,31 +15,43 @@ TCPClient WemoClient;
 int wemoPort = 49153;
 const char *wemoIP[6] = {"192.168.1.30","192.168.1.31","192.168.1.32","192.168.1.33","192.168.1.34","192.168.1.35"};
 
+// default addresses above seed the discovery cache, outlets are looked up through it
+#include "wemoDiscovery.h"
+#include "wemoXml.h"
+
+const unsigned int WEMO_RESPONSE_MS = 2000;  // how long to wait for an outlet to answer
+
 // Function Prototypes
-void switchON(int wemo);
-void switchOFF(int wemo);
-void wemoWrite(int outlet, bool wemoState);
+bool switchON(int wemo);
+bool switchOFF(int wemo);
+bool wemoWrite(int outlet, bool wemoState);
+bool wemoWriteConfirmed(int outlet, bool wemoState);
+int wemoRead(int outlet);
+bool wemoRequest(int wemo, const char *service, const char *action, const char *arguments);
+void wemoSend(Print &client, const char *service, const char *action, const char *arguments, bool keepAlive=false);
+bool wemoResponse(const char *element, char *value, int len, unsigned int timeout=WEMO_RESPONSE_MS);
 
-// Turn on/off wemo outlets similar to digitalWrite
-void wemoWrite(int outlet, bool wemoState) {
+// Turn on/off wemo outlets similar to digitalWrite, returns false if the outlet could not be reached
+bool wemoWrite(int outlet, bool wemoState) {
   if(wemoState) {
-    switchON(outlet);
+    return switchON(outlet);
   }
   else {
-    switchOFF(outlet);
+    return switchOFF(outlet);
   }
 }
 
 
 
 // turn on specified wemo outlet
-void switchON(int wemo) {
+bool switchON(int wemo) {
   
   String data1;
+  bool sent = false;
   
   Serial.printf("Switching On Wemo #%i\n",wemo);
   data1+="<?xml version=\"1.0\" encoding=\"utf-8\"?><s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body><u:SetBinaryState xmlns:u=\"urn:Belkin:service:basicevent:1\"><BinaryState>1</BinaryState></u:SetBinaryState></s:Body></s:Envelope>"; // Use HTML encoding for comma's
-  if (WemoClient.connect(wemoIP[wemo],wemoPort)) {
+  if (WemoClient.connect(wemoAddress(wemo),wemoOutletPort(wemo))) {
         WemoClient.println("POST /upnp/control/basicevent1 HTTP/1.1");
         WemoClient.println("Content-Type: text/xml; charset=utf-8");
         WemoClient.println("SOAPACTION: \"urn:Belkin:service:basicevent:1#SetBinaryState\"");
@@ -49,20 +61,26 @@ void switchON(int wemo) {
         WemoClient.println();
         WemoClient.print(data1);
         WemoClient.println();
+        sent = true;
     }
+  else {
+    wemoMarkStale(wemo);
+  }
 
   if (WemoClient.connected()) {
      WemoClient.stop();
   }
+  return sent;
 }
 
 // turn off wemo outlet specified
-void switchOFF(int wemo){
+bool switchOFF(int wemo){
   String data1;
+  bool sent = false;
   
   Serial.printf("Switching Off Wemo #%i \n",wemo);
   data1+="<?xml version=\"1.0\" encoding=\"utf-8\"?><s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body><u:SetBinaryState xmlns:u=\"urn:Belkin:service:basicevent:1\"><BinaryState>0</BinaryState></u:SetBinaryState></s:Body></s:Envelope>"; // Use HTML encoding for comma's
-  if (WemoClient.connect(wemoIP[wemo],wemoPort)) {
+  if (WemoClient.connect(wemoAddress(wemo),wemoOutletPort(wemo))) {
         WemoClient.println("POST /upnp/control/basicevent1 HTTP/1.1");
         WemoClient.println("Content-Type: text/xml; charset=utf-8");
         WemoClient.println("SOAPACTION: \"urn:Belkin:service:basicevent:1#SetBinaryState\"");
@@ -72,11 +90,107 @@ void switchOFF(int wemo){
         WemoClient.println();
         WemoClient.print(data1);
         WemoClient.println();
+        sent = true;
     }
+  else {
+    wemoMarkStale(wemo);
+  }
    
   if (WemoClient.connected()) {
      WemoClient.stop();
   }
+  return sent;
+}
+
+// send a SOAP action to an outlet, service is "basicevent" or "insight"
+bool wemoRequest(int wemo, const char *service, const char *action, const char *arguments) {
+  if (!WemoClient.connect(wemoAddress(wemo),wemoOutletPort(wemo))) {
+    wemoMarkStale(wemo);
+    return false;
+  }
+  wemoSend(WemoClient, service, action, arguments);
+  return true;
+}
+
+// write a SOAP request to an already connected client (or any other Print)
+void wemoSend(Print &client, const char *service, const char *action, const char *arguments, bool keepAlive) {
+  const char *envelope = "<?xml version=\"1.0\" encoding=\"utf-8\"?><s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>";
+  const char *closing = "</s:Body></s:Envelope>";
+  char open[96], close[40];
+
+  snprintf(open, sizeof(open), "<u:%s xmlns:u=\"urn:Belkin:service:%s:1\">", action, service);
+  snprintf(close, sizeof(close), "</u:%s>", action);
+  client.printf("POST /upnp/control/%s1 HTTP/1.1\r\n", service);
+  client.println("Content-Type: text/xml; charset=utf-8");
+  client.printf("SOAPACTION: \"urn:Belkin:service:%s:1#%s\"\r\n", service, action);
+  client.println(keepAlive ? "Connection: keep-alive" : "Connection: close");
+  client.print("Content-Length: ");
+  client.println(strlen(envelope) + strlen(open) + strlen(arguments) + strlen(close) + strlen(closing));
+  client.println();
+  client.print(envelope);
+  client.print(open);
+  client.print(arguments);
+  client.print(close);
+  client.print(closing);
+}
+
+// read the response to wemoRequest() as it arrives and pull out one element,
+// returns false on timeout, HTTP error or SOAP fault
+bool wemoResponse(const char *element, char *value, int len, unsigned int timeout) {
+  WemoXmlReader reader;
+  unsigned int start = millis();
+  bool found = false;
+  bool fault = false;
+
+  while ((millis() - start) < timeout) {
+    int event = reader.next(WemoClient);
+    if (event == WEMO_XML_ELEMENT) {
+      if (strcmp(reader.name(), element) == 0) {
+        strncpy(value, reader.value(), len - 1);
+        value[len - 1] = '\0';
+        found = true;
+      }
+      else if (strcmp(reader.name(), "errorCode") == 0) {
+        Serial.printf("Wemo SOAP fault %s\n", reader.value());
+        fault = true;
+      }
+    }
+    else if (event != WEMO_XML_MORE) {
+      break;
+    }
+    else if (!WemoClient.connected()) {
+      break;
+    }
+  }
+  WemoClient.stop();
+  return found && !fault && (reader.status() == 200);
+}
+
+// switch an outlet and wait for it to report the new state
+bool wemoWriteConfirmed(int outlet, bool wemoState) {
+  char value[8];
+
+  if (!wemoRequest(outlet, "basicevent", "SetBinaryState", wemoState ? "<BinaryState>1</BinaryState>" : "<BinaryState>0</BinaryState>")) {
+    return false;
+  }
+  if (!wemoResponse("BinaryState", value, sizeof(value))) {
+    return false;
+  }
+  // outlets answer "Error" when asked for the state they are already in
+  return (strcmp(value, "Error") == 0) || ((atoi(value) != 0) == wemoState);
+}
+
+// read an outlet's state, returns 1 on, 0 off or -1 if it did not answer
+int wemoRead(int outlet) {
+  char value[24];  // Insight outlets append |timestamps
+
+  if (!wemoRequest(outlet, "basicevent", "GetBinaryState", "")) {
+    return -1;
+  }
+  if (!wemoResponse("BinaryState", value, sizeof(value))) {
+    return -1;
+  }
+  return (atoi(value) != 0) ? 1 : 0;  // Insight reports 8 for on but idle
 }
 
 #endif // _WEMO_H_
\ No newline at end of file
@@ -0,0 +1,315 @@
+#ifndef _WEMODISCOVERY_H_
+#define _WEMODISCOVERY_H_
+
+/*
+ *  Project: Wemo IoT Library
+ *  Description: SSDP discovery and EEPROM address cache for the IoT Classroom Wemo outlets
+ *  Date:     19-OCT-2026
+ */
+
+#include "application.h"
+
+/* Usage:
+ * Included by wemo.h after wemoIP[] and wemoPort are declared; those are used to
+ * seed the cache the first time and to tell the classroom outlets apart.
+ *
+ * wemoBegin();          // optional in setup(), loads the cached table from EEPROM
+ * wemoDiscoveryLoop();  // call every pass through loop(), never blocks
+ *
+ * Wemo outlets hop between ports 49152-49155 (and occasionally change IP). The
+ * cache maps each outlet's UDN (its SSDP identity) to the last IP:port it answered
+ * on, so commands go straight to the right address after a reboot. Revalidation
+ * runs in the background and is brought forward whenever a connect fails.
+ */
+
+const uint16_t WEMO_SSDP_PORT = 1900;
+const uint16_t WEMO_LOCAL_PORT = 1901;
+const int WEMO_CACHE_ADDR = 0;                   // EEPROM offset of the cache
+const uint32_t WEMO_CACHE_MAGIC = 0x57454D4F;    // "WEMO"
+const uint8_t WEMO_CACHE_VERSION = 1;
+const unsigned int WEMO_REVALIDATE_MS = 60000;   // periodic M-SEARCH
+const unsigned int WEMO_SEARCH_WINDOW_MS = 3000; // MX 2 + slack
+const int WEMO_MAX_OUTLETS = 6;
+const int WEMO_UDN_LEN = 40;
+
+// outlet flags
+const uint8_t WEMO_FOUND = 0x01;  // answered a search since boot
+const uint8_t WEMO_STALE = 0x02;  // last connect failed, address needs revalidating
+
+struct WemoOutlet {
+  uint8_t ip[4];
+  uint16_t port;
+  uint8_t flags;
+  char udn[WEMO_UDN_LEN];
+};
+
+struct WemoCache {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t count;
+  WemoOutlet outlet[WEMO_MAX_OUTLETS];
+  uint16_t checksum;
+};
+
+WemoCache wemoCache;
+UDP WemoUDP;
+bool wemoCacheLoaded = false;
+bool wemoCacheDirty = false;
+bool wemoCachePinned = false;   // wemoSetAddress() was used, the table is not saved
+bool wemoSearching = false;
+unsigned int wemoLastSearch;
+char wemoPacket[512];
+
+// Function Prototypes
+void wemoBegin();
+void wemoDiscoveryLoop();
+void wemoSearch();
+IPAddress wemoAddress(int outlet);
+uint16_t wemoOutletPort(int outlet);
+void wemoMarkStale(int outlet);
+void wemoSetAddress(int outlet, IPAddress ip, uint16_t port, const char *udn=NULL);
+
+uint16_t wemoCacheChecksum(const WemoCache &cache) {
+  const uint8_t *p = (const uint8_t *)&cache;
+  uint16_t a = 0, b = 0;
+  for (size_t i = 0; i < offsetof(WemoCache, checksum); i++) {  // fletcher-16
+    a = (a + p[i]) % 255;
+    b = (b + a) % 255;
+  }
+  return (b << 8) | a;
+}
+
+void wemoSaveCache() {
+  if (wemoCachePinned) {
+    return;
+  }
+  wemoCache.checksum = wemoCacheChecksum(wemoCache);
+  EEPROM.put(WEMO_CACHE_ADDR, wemoCache);
+  wemoCacheDirty = false;
+}
+
+// seed the table from the hardcoded classroom addresses
+void wemoSeedCache() {
+  int count = sizeof(wemoIP) / sizeof(wemoIP[0]);
+  if (count > WEMO_MAX_OUTLETS) {
+    count = WEMO_MAX_OUTLETS;
+  }
+  memset(&wemoCache, 0, sizeof(wemoCache));
+  wemoCache.magic = WEMO_CACHE_MAGIC;
+  wemoCache.version = WEMO_CACHE_VERSION;
+  wemoCache.count = count;
+  for (int i = 0; i < count; i++) {
+    int a, b, c, d;
+    if (sscanf(wemoIP[i], "%d.%d.%d.%d", &a, &b, &c, &d) == 4) {
+      wemoCache.outlet[i].ip[0] = a;
+      wemoCache.outlet[i].ip[1] = b;
+      wemoCache.outlet[i].ip[2] = c;
+      wemoCache.outlet[i].ip[3] = d;
+    }
+    wemoCache.outlet[i].port = wemoPort;
+  }
+}
+
+// load the cached table, falls back to the hardcoded addresses on a blank or corrupt EEPROM
+void wemoBegin() {
+  EEPROM.get(WEMO_CACHE_ADDR, wemoCache);
+  if ((wemoCache.magic != WEMO_CACHE_MAGIC) || (wemoCache.version != WEMO_CACHE_VERSION) ||
+      (wemoCache.count == 0) || (wemoCache.count > WEMO_MAX_OUTLETS) ||
+      (wemoCache.checksum != wemoCacheChecksum(wemoCache))) {
+    Serial.printf("Wemo cache empty, using default addresses\n");
+    wemoSeedCache();
+    wemoCacheDirty = true;
+  }
+  for (int i = 0; i < wemoCache.count; i++) {
+    wemoCache.outlet[i].flags = 0;  // flags are per boot
+  }
+  wemoCacheLoaded = true;
+  wemoLastSearch = millis() - WEMO_REVALIDATE_MS;  // revalidate as soon as the network is up
+}
+
+IPAddress wemoAddress(int outlet) {
+  if (!wemoCacheLoaded) {
+    wemoBegin();
+  }
+  if (outlet < 0 || outlet >= wemoCache.count) {
+    return IPAddress();
+  }
+  const uint8_t *ip = wemoCache.outlet[outlet].ip;
+  return IPAddress(ip[0], ip[1], ip[2], ip[3]);
+}
+
+uint16_t wemoOutletPort(int outlet) {
+  if (!wemoCacheLoaded) {
+    wemoBegin();
+  }
+  if (outlet < 0 || outlet >= wemoCache.count) {
+    return wemoPort;
+  }
+  return wemoCache.outlet[outlet].port;
+}
+
+// called when a connect fails, pulls the next search forward
+void wemoMarkStale(int outlet) {
+  if (outlet < 0 || outlet >= wemoCache.count) {
+    return;
+  }
+  wemoCache.outlet[outlet].flags |= WEMO_STALE;
+}
+
+// pin an outlet to a known address (and optionally identity) for this session, e.g. for bench testing.
+// The table stops being saved, so neither the pinned addresses nor moves found afterwards reach EEPROM
+void wemoSetAddress(int outlet, IPAddress ip, uint16_t port, const char *udn) {
+  if (!wemoCacheLoaded) {
+    wemoBegin();
+  }
+  if (outlet < 0 || outlet >= WEMO_MAX_OUTLETS) {
+    return;
+  }
+  wemoCachePinned = true;
+  if (outlet >= wemoCache.count) {
+    wemoCache.count = outlet + 1;
+  }
+  WemoOutlet &o = wemoCache.outlet[outlet];
+  for (int i = 0; i < 4; i++) {
+    o.ip[i] = ip[i];
+  }
+  o.port = port;
+  o.flags = WEMO_FOUND;
+  if (udn != NULL) {
+    strncpy(o.udn, udn, WEMO_UDN_LEN - 1);
+    o.udn[WEMO_UDN_LEN - 1] = '\0';
+  }
+}
+
+void wemoSearch() {
+  if (!WiFi.ready()) {
+    return;
+  }
+  if (!wemoSearching) {
+    WemoUDP.begin(WEMO_LOCAL_PORT);
+  }
+  WemoUDP.beginPacket(IPAddress(239, 255, 255, 250), WEMO_SSDP_PORT);
+  WemoUDP.print("M-SEARCH * HTTP/1.1\r\n");
+  WemoUDP.print("HOST: 239.255.255.250:1900\r\n");
+  WemoUDP.print("MAN: \"ssdp:discover\"\r\n");
+  WemoUDP.print("MX: 2\r\n");
+  WemoUDP.print("ST: urn:Belkin:service:basicevent:1\r\n");
+  WemoUDP.print("\r\n");
+  WemoUDP.endPacket();
+  wemoSearching = true;
+  wemoLastSearch = millis();
+}
+
+// case-insensitive match of an SSDP header name, returns the value or NULL
+const char *wemoHeader(const char *line, const char *name) {
+  size_t len = strlen(name);
+  if (strncasecmp(line, name, len) != 0 || line[len] != ':') {
+    return NULL;
+  }
+  line += len + 1;
+  while (*line == ' ') {
+    line++;
+  }
+  return line;
+}
+
+// match one search response to an outlet by UDN, or claim an unidentified outlet by IP
+void wemoParseResponse(char *packet) {
+  int a, b, c, d, port;
+  bool haveLocation = false;
+  char udn[WEMO_UDN_LEN] = "";
+
+  for (char *line = strtok(packet, "\r\n"); line != NULL; line = strtok(NULL, "\r\n")) {
+    const char *value;
+    if ((value = wemoHeader(line, "LOCATION")) != NULL) {
+      haveLocation = (sscanf(value, "http://%d.%d.%d.%d:%d", &a, &b, &c, &d, &port) == 5);
+    }
+    else if ((value = wemoHeader(line, "USN")) != NULL) {
+      const char *end = strstr(value, "::");
+      size_t len = end ? (size_t)(end - value) : strlen(value);
+      if (len >= WEMO_UDN_LEN) {
+        len = WEMO_UDN_LEN - 1;
+      }
+      memcpy(udn, value, len);
+      udn[len] = '\0';
+    }
+  }
+  if (!haveLocation || udn[0] == '\0') {
+    return;
+  }
+
+  int match = -1;
+  for (int i = 0; i < wemoCache.count && match < 0; i++) {
+    if (strcmp(wemoCache.outlet[i].udn, udn) == 0) {
+      match = i;
+    }
+  }
+  for (int i = 0; i < wemoCache.count && match < 0; i++) {
+    const uint8_t *ip = wemoCache.outlet[i].ip;
+    if (wemoCache.outlet[i].udn[0] == '\0' && ip[0] == a && ip[1] == b && ip[2] == c && ip[3] == d) {
+      strcpy(wemoCache.outlet[i].udn, udn);
+      wemoCacheDirty = true;
+      match = i;
+    }
+  }
+  if (match < 0) {
+    return;  // not one of ours
+  }
+
+  WemoOutlet &o = wemoCache.outlet[match];
+  if (o.ip[0] != a || o.ip[1] != b || o.ip[2] != c || o.ip[3] != d || o.port != port) {
+    Serial.printf("Wemo #%i moved to %i.%i.%i.%i:%i\n", match, a, b, c, d, port);
+    o.ip[0] = a;
+    o.ip[1] = b;
+    o.ip[2] = c;
+    o.ip[3] = d;
+    o.port = port;
+    wemoCacheDirty = true;
+  }
+  o.flags = WEMO_FOUND;
+}
+
+// non-blocking, sends a search when due and drains any responses
+void wemoDiscoveryLoop() {
+  if (!wemoCacheLoaded) {
+    wemoBegin();
+  }
+  if (!WiFi.ready()) {
+    return;
+  }
+
+  if (!wemoSearching) {
+    bool stale = false;
+    for (int i = 0; i < wemoCache.count; i++) {
+      if (wemoCache.outlet[i].flags & WEMO_STALE) {
+        stale = true;
+      }
+    }
+    if (stale || (millis() - wemoLastSearch) >= WEMO_REVALIDATE_MS) {
+      wemoSearch();
+    }
+    return;
+  }
+
+  int size;
+  while ((size = WemoUDP.parsePacket()) > 0) {
+    int len = WemoUDP.read((uint8_t *)wemoPacket, sizeof(wemoPacket) - 1);
+    if (len > 0) {
+      wemoPacket[len] = '\0';
+      wemoParseResponse(wemoPacket);
+    }
+  }
+
+  if ((millis() - wemoLastSearch) >= WEMO_SEARCH_WINDOW_MS) {
+    WemoUDP.stop();
+    wemoSearching = false;
+    for (int i = 0; i < wemoCache.count; i++) {
+      wemoCache.outlet[i].flags &= ~WEMO_STALE;  // retry on the next periodic search
+    }
+    if (wemoCacheDirty) {
+      wemoSaveCache();
+    }
+  }
+}
+
+#endif // _WEMODISCOVERY_H_
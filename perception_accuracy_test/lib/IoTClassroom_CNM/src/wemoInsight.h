@@ -0,0 +1,216 @@
+#ifndef _WEMOINSIGHT_H_
+#define _WEMOINSIGHT_H_
+
+/*
+ *  Project: Wemo IoT Library
+ *  Description: Background power sampling for Wemo Insight outlets
+ *  Date:     19-OCT-2026
+ */
+
+#include "application.h"
+#include "wemo.h"
+
+/* Usage:
+ * WemoInsight insight;
+ * insight.add(2);                 // outlet numbers as used with wemoWrite()
+ * insight.add(4);
+ * insight.begin(10000);           // each outlet sampled every 10 seconds
+ * insight.loop();                 // call every pass through loop()
+ * insight.latest(2);              // instantaneous power in mW, O(1)
+ * insight.average(2);             // mean of the last WEMO_INSIGHT_SAMPLES, O(1)
+ *
+ * Polls are staggered evenly across the period so no two outlets are queried in the
+ * same pass, and each outlet keeps its own keep-alive connection so the (blocking)
+ * connect is only paid when the outlet has closed it. Responses are read with
+ * WemoXmlReader a few bytes at a time as they arrive, loop() never waits on one.
+ */
+
+const int WEMO_INSIGHT_MAX = 6;         // outlets that can be sampled
+const int WEMO_INSIGHT_SAMPLES = 16;    // ring buffer depth per outlet
+const unsigned int WEMO_INSIGHT_TIMEOUT = 3000;
+const int WEMO_INSIGHT_POWERFIELD = 7;  // InsightParams: state|lastchange|onfor|ontoday|ontotal|period|x|currentmW|todaymW|totalmW|threshold
+
+// fixed-size sample history with a running sum, so latest() and average() are O(1)
+class InsightRing {
+  uint32_t _sample[WEMO_INSIGHT_SAMPLES];
+  int _head, _count;
+  uint32_t _sum;
+
+  public:
+    InsightRing() {
+      clear();
+    }
+
+    void clear() {
+      _head = 0;
+      _count = 0;
+      _sum = 0;
+    }
+
+    void push(uint32_t value) {
+      if (_count == WEMO_INSIGHT_SAMPLES) {
+        _sum -= _sample[_head];
+      }
+      else {
+        _count++;
+      }
+      _sample[_head] = value;
+      _sum += value;
+      _head = (_head + 1) % WEMO_INSIGHT_SAMPLES;
+    }
+
+    uint32_t latest() {
+      return _count ? _sample[(_head + WEMO_INSIGHT_SAMPLES - 1) % WEMO_INSIGHT_SAMPLES] : 0;
+    }
+
+    uint32_t average() {
+      return _count ? _sum / _count : 0;
+    }
+
+    int count() {
+      return _count;
+    }
+};
+
+class WemoInsight {
+
+  struct Meter {
+    int outlet;
+    TCPClient client;
+    WemoXmlReader reader;
+    InsightRing power;
+    unsigned int nextPoll, sentAt;
+    bool waiting;
+    int failures;
+  };
+
+  Meter _meter[WEMO_INSIGHT_MAX];
+  int _count;
+  unsigned int _period;
+
+  public:
+    WemoInsight() {
+      _count = 0;
+      _period = 10000;
+    }
+
+    // register an Insight outlet, returns false when full. One added after begin()
+    // is due at once, loop() still starts only one poll at a time
+    bool add(int outlet) {
+      if (_count >= WEMO_INSIGHT_MAX) {
+        return false;
+      }
+      Meter &m = _meter[_count++];
+      m.outlet = outlet;
+      m.nextPoll = millis();
+      m.waiting = false;
+      m.failures = 0;
+      m.power.clear();
+      return true;
+    }
+
+    // spread the first poll of each outlet evenly across one period
+    void begin(unsigned int periodMs) {
+      _period = periodMs;
+      unsigned int now = millis();
+      for (int i=0; i<_count; i++) {
+        _meter[i].nextPoll = now + (_period * i) / _count;
+      }
+    }
+
+    // advance in-flight responses and start at most one due poll
+    void loop() {
+      bool started = false;
+      for (int i=0; i<_count; i++) {
+        Meter &m = _meter[i];
+        if (m.waiting) {
+          readMeter(m);
+        }
+        else if (!started && ((int)(millis() - m.nextPoll) >= 0)) {
+          pollMeter(m);
+          started = true;
+        }
+      }
+    }
+
+    uint32_t latest(int outlet) {
+      Meter *m = find(outlet);
+      return m ? m->power.latest() : 0;
+    }
+
+    uint32_t average(int outlet) {
+      Meter *m = find(outlet);
+      return m ? m->power.average() : 0;
+    }
+
+    int samples(int outlet) {
+      Meter *m = find(outlet);
+      return m ? m->power.count() : 0;
+    }
+
+    int failures(int outlet) {
+      Meter *m = find(outlet);
+      return m ? m->failures : 0;
+    }
+
+  private:
+    Meter *find(int outlet) {
+      for (int i=0; i<_count; i++) {
+        if (_meter[i].outlet == outlet) {
+          return &_meter[i];
+        }
+      }
+      return NULL;
+    }
+
+    void pollMeter(Meter &m) {
+      m.nextPoll += _period;
+      if ((int)(millis() - m.nextPoll) >= 0) {
+        m.nextPoll = millis() + _period;  // fell behind, don't burst to catch up
+      }
+      if (!m.client.connected()) {
+        if (!m.client.connect(wemoAddress(m.outlet), wemoOutletPort(m.outlet))) {
+          wemoMarkStale(m.outlet);
+          m.failures++;
+          return;
+        }
+      }
+      m.reader.begin();
+      wemoSend(m.client, "insight", "GetInsightParams", "", true);
+      m.sentAt = millis();
+      m.waiting = true;
+    }
+
+    void readMeter(Meter &m) {
+      int event;
+      while ((event = m.reader.next(m.client)) == WEMO_XML_ELEMENT) {
+        if (strcmp(m.reader.name(), "InsightParams") == 0) {
+          m.power.push(powerField(m.reader.value()));
+        }
+      }
+      if (event == WEMO_XML_END) {
+        m.waiting = false;
+        if (m.reader.status() != 200) {
+          m.failures++;
+        }
+      }
+      else if ((event == WEMO_XML_ERROR) || !m.client.connected() || ((millis() - m.sentAt) >= WEMO_INSIGHT_TIMEOUT)) {
+        m.client.stop();
+        m.waiting = false;
+        m.failures++;
+      }
+    }
+
+    static uint32_t powerField(const char *params) {
+      for (int field=0; field<WEMO_INSIGHT_POWERFIELD; field++) {
+        params = strchr(params, '|');
+        if (params == NULL) {
+          return 0;
+        }
+        params++;
+      }
+      return strtoul(params, NULL, 10);
+    }
+};
+
+#endif // _WEMOINSIGHT_H_
@@ -0,0 +1,350 @@
+#ifndef _WEMOXML_H_
+#define _WEMOXML_H_
+
+/*
+ *  Project: Wemo IoT Library
+ *  Description: Streaming pull parser for Wemo SOAP/HTTP responses
+ *  Date:     19-OCT-2026
+ */
+
+#include "application.h"
+
+/* Usage:
+ * WemoXmlReader reader;
+ * reader.begin();
+ * while (...) {
+ *   int event = reader.next(WemoClient);   // consumes whatever bytes have arrived
+ *   if (event == WEMO_XML_ELEMENT && strcmp(reader.name(), "BinaryState") == 0) {
+ *     state = atoi(reader.value());
+ *   }
+ *   if (event == WEMO_XML_END) break;
+ * }
+ *
+ * The reader skips the HTTP status line and headers (keeping the status code and
+ * Content-Length), then reports every leaf element of the SOAP body as it closes:
+ * name() is the local name with any namespace prefix stripped, value() its decoded
+ * text. Memory use is fixed - tag names and values longer than the buffers are cut
+ * short and flagged by truncated() until the next begin(). An entity reference longer
+ * than the entity buffer is skipped up to its ';' and decoded as '?', which also sets
+ * truncated(). Comments and CDATA sections are skipped whole, even when they contain
+ * '>'; a DOCTYPE or processing instruction ends at its first '>'. Nothing is
+ * buffered beyond the element being read.
+ */
+
+const int WEMO_XML_ERROR = -1;   // malformed HTTP response
+const int WEMO_XML_MORE = 0;     // need more bytes
+const int WEMO_XML_ELEMENT = 1;  // name()/value() hold a completed leaf element
+const int WEMO_XML_END = 2;      // Content-Length bytes of body consumed
+
+const int WEMO_XML_NAMELEN = 24;
+const int WEMO_XML_VALUELEN = 128;
+
+class WemoXmlReader {
+
+  enum State { STATUS, HEADER, TEXT, TAGSTART, STARTTAG, ENDTAG, ATTRIBUTES, MARKUP, COMMENT, CDATA, SKIP, DONE };
+
+  State _state;
+  int _status;
+  long _contentLength, _bodyRead;
+  char _line[32];       // header name/value prefix, enough for Content-Length
+  int _lineLen;
+  char _name[WEMO_XML_NAMELEN];
+  char _value[WEMO_XML_VALUELEN];
+  char _tag[WEMO_XML_NAMELEN];
+  int _nameLen, _valueLen, _tagLen;
+  char _entity[8];
+  int _entityLen;       // -1 when not inside an &entity;, sizeof(_entity) when skipping an over-long one
+  bool _leaf, _truncated;
+  char _prev;
+
+  public:
+    WemoXmlReader() {
+      begin();
+    }
+
+    // reset for a new response
+    void begin() {
+      _state = STATUS;
+      _status = 0;
+      _contentLength = -1;
+      _bodyRead = 0;
+      _lineLen = 0;
+      _nameLen = _valueLen = _tagLen = 0;
+      _name[0] = _value[0] = '\0';
+      _entityLen = -1;
+      _leaf = false;
+      _truncated = false;
+      _prev = '\0';
+    }
+
+    // pull from a stream until an event or until no more bytes are available
+    int next(Stream &in) {
+      while (in.available() > 0) {
+        int event = feed(in.read());
+        if (event != WEMO_XML_MORE) {
+          return event;
+        }
+      }
+      return (_state == DONE) ? WEMO_XML_END : WEMO_XML_MORE;
+    }
+
+    // push one byte, returns an event as for next()
+    int feed(char c) {
+      switch (_state) {
+        case STATUS:
+          return statusByte(c);
+        case HEADER:
+          return headerByte(c);
+        case DONE:
+          return WEMO_XML_END;
+        default:
+          break;
+      }
+
+      int event = bodyByte(c);
+      _bodyRead++;
+      if ((_contentLength >= 0) && (_bodyRead >= _contentLength)) {
+        _state = DONE;
+        if (event == WEMO_XML_MORE) {
+          event = WEMO_XML_END;
+        }
+      }
+      return event;
+    }
+
+    const char *name() { return _name; }
+    const char *value() { return _value; }
+    int status() { return _status; }
+    long contentLength() { return _contentLength; }
+    bool truncated() { return _truncated; }
+    bool done() { return _state == DONE; }
+
+  private:
+    // "HTTP/1.1 200 OK" - only the code is kept
+    int statusByte(char c) {
+      if (c == '\n') {
+        _line[_lineLen] = '\0';
+        const char *code = strchr(_line, ' ');
+        if (strncmp(_line, "HTTP/", 5) != 0 || code == NULL) {
+          _state = DONE;
+          return WEMO_XML_ERROR;
+        }
+        _status = atoi(code + 1);
+        _lineLen = 0;
+        _state = HEADER;
+      }
+      else if (_lineLen < (int)sizeof(_line) - 1) {
+        _line[_lineLen++] = c;
+      }
+      return WEMO_XML_MORE;
+    }
+
+    int headerByte(char c) {
+      if (c == '\r') {
+        return WEMO_XML_MORE;
+      }
+      if (c != '\n') {
+        if (_lineLen < (int)sizeof(_line) - 1) {
+          _line[_lineLen++] = c;
+        }
+        return WEMO_XML_MORE;
+      }
+      if (_lineLen == 0) {  // blank line ends the headers
+        _state = (_contentLength == 0) ? DONE : TEXT;
+        return (_state == DONE) ? WEMO_XML_END : WEMO_XML_MORE;
+      }
+      _line[_lineLen] = '\0';
+      if (strncasecmp(_line, "Content-Length:", 15) == 0) {
+        _contentLength = atol(_line + 15);
+      }
+      _lineLen = 0;
+      return WEMO_XML_MORE;
+    }
+
+    int bodyByte(char c) {
+      int event = WEMO_XML_MORE;
+
+      switch (_state) {
+        case TEXT:
+          if (c == '<') {
+            _state = TAGSTART;
+          }
+          else if (_leaf) {
+            textByte(c);
+          }
+          break;
+        case TAGSTART:
+          _tagLen = 0;
+          if (c == '/') {
+            _state = ENDTAG;
+          }
+          else if (c == '?') {  // XML declaration or processing instruction
+            _state = SKIP;
+          }
+          else if (c == '!') {  // comment, CDATA or DOCTYPE - told apart by what follows
+            _state = MARKUP;
+          }
+          else {
+            _state = STARTTAG;
+            tagByte(c);
+          }
+          break;
+        case STARTTAG:
+          if (c == '>' || c == ' ' || c == '/' || c == '\t' || c == '\r' || c == '\n') {
+            openElement();
+            if (c == '>') {
+              _state = TEXT;
+            }
+            else {
+              _state = ATTRIBUTES;
+            }
+            if (c == '/') {
+              _leaf = true;  // <tag/> closes with an empty value
+            }
+          }
+          else {
+            tagByte(c);
+          }
+          break;
+        case ATTRIBUTES:
+          if (c == '>') {
+            _state = TEXT;
+            if (_prev == '/' && _leaf) {
+              event = closeElement(_name);
+            }
+          }
+          break;
+        case ENDTAG:
+          if (c == '>') {
+            _tag[_tagLen] = '\0';
+            event = closeElement(localName(_tag));
+            _state = TEXT;
+          }
+          else {
+            tagByte(c);
+          }
+          break;
+        case MARKUP:
+          tagByte(c);
+          _tag[_tagLen] = '\0';
+          if (strcmp(_tag, "--") == 0) {
+            _state = COMMENT;
+            _tagLen = 0;
+          }
+          else if (strcmp(_tag, "[CDATA[") == 0) {
+            _state = CDATA;
+            _tagLen = 0;
+          }
+          else if (c == '>') {
+            _state = TEXT;
+          }
+          else if (strncmp(_tag, "--", _tagLen) != 0 && strncmp(_tag, "[CDATA[", _tagLen) != 0) {
+            _state = SKIP;
+          }
+          break;
+        case COMMENT:  // ends at "-->", _tagLen counts the '-' run before it
+        case CDATA:    // ends at "]]>", likewise for ']'
+          if (c == ((_state == COMMENT) ? '-' : ']')) {
+            _tagLen++;
+          }
+          else if (c == '>' && _tagLen >= 2) {
+            _state = TEXT;
+          }
+          else {
+            _tagLen = 0;
+          }
+          break;
+        case SKIP:
+          if (c == '>') {
+            _state = TEXT;
+          }
+          break;
+        default:
+          break;
+      }
+      _prev = c;
+      return event;
+    }
+
+    void tagByte(char c) {
+      if (_tagLen < WEMO_XML_NAMELEN - 1) {
+        _tag[_tagLen++] = c;
+      }
+      else {
+        _truncated = true;
+      }
+    }
+
+    static const char *localName(const char *tag) {
+      const char *colon = strchr(tag, ':');
+      return colon ? colon + 1 : tag;
+    }
+
+    void openElement() {
+      _tag[_tagLen] = '\0';
+      strcpy(_name, localName(_tag));
+      _valueLen = 0;
+      _value[0] = '\0';
+      _entityLen = -1;
+      _leaf = true;
+    }
+
+    // a leaf is an element with no child elements - parents are not reported
+    int closeElement(const char *name) {
+      if (!_leaf || strcmp(name, _name) != 0) {
+        _leaf = false;
+        return WEMO_XML_MORE;
+      }
+      _leaf = false;
+      _value[_valueLen] = '\0';
+      return WEMO_XML_ELEMENT;
+    }
+
+    void textByte(char c) {
+      if (_entityLen >= 0) {
+        if (c != ';') {
+          if (_entityLen < (int)sizeof(_entity) - 1) {
+            _entity[_entityLen++] = c;
+          }
+          else {
+            _entityLen = sizeof(_entity);  // too long for any entity we decode, skip to ';'
+          }
+          return;
+        }
+        if (_entityLen == (int)sizeof(_entity)) {
+          _truncated = true;
+          c = '?';
+        }
+        else {
+          _entity[_entityLen] = '\0';
+          c = decodeEntity(_entity);
+        }
+        _entityLen = -1;
+      }
+      else if (c == '&') {
+        _entityLen = 0;
+        return;
+      }
+      if (_valueLen < WEMO_XML_VALUELEN - 1) {
+        _value[_valueLen++] = c;
+        _value[_valueLen] = '\0';
+      }
+      else {
+        _truncated = true;
+      }
+    }
+
+    static char decodeEntity(const char *entity) {
+      if (strcmp(entity, "lt") == 0) return '<';
+      if (strcmp(entity, "gt") == 0) return '>';
+      if (strcmp(entity, "amp") == 0) return '&';
+      if (strcmp(entity, "quot") == 0) return '"';
+      if (strcmp(entity, "apos") == 0) return '\'';
+      if (entity[0] == '#') {
+        return (entity[1] == 'x') ? strtol(entity + 2, NULL, 16) : atoi(entity + 1);
+      }
+      return '?';
+    }
+};
+
+#endif // _WEMOXML_H_
@@ -8,6 +8,7 @@
 #include "Particle.h"
 #include "Adafruit_SSD1306.h" 
 #include "Adafruit_GFX.h"
+#include "SSD1306_Widgets.h"
 #include "Adafruit_BME280.h"
 #include "Encoder.h"
 #include "Button.h"
@@ -45,12 +46,35 @@ int gameMode = 0;
 int servoStartPosition = 0;
 byte status;
 
+// fixed UI text, rasterized by the compiler and copied in with blitText()
+constexpr auto TXT_TURN_KNOB = rasterizeText("TURN RIGHT KNOB TO");
+constexpr auto TXT_SELECT_TABLE = rasterizeText("SELECT YOUR TABLE.");
+constexpr auto TXT_SELECT_MODE = rasterizeText("SELECT GAME MODE.");
+constexpr auto TXT_PUSH_TO_BEGIN = rasterizeText("PUSH BUTTON TO BEGIN.");
+constexpr auto TXT_PUSH_TO_GUESS = rasterizeText("PUSH AGAIN TO GUESS.");
+constexpr auto TXT_PUSH_TO_END = rasterizeText("PUSH BUTTON TO END");
+constexpr auto TXT_USING_KNOB = rasterizeText("USING RIGHT KNOB.");
+constexpr auto TXT_REPLICATE_HUE = rasterizeText("REPLICATE CURRENT");
+constexpr auto TXT_HUE_BULB = rasterizeText("HUE BULB COLOR BY");
+constexpr auto TXT_TURNING_KNOB = rasterizeText("TURNING RIGHT KNOB.");
+constexpr auto TXT_GUESS_MIDPOINT = rasterizeText("GUESS LINE MIDPOINT");
+constexpr auto TXT_GUESS_TEMP = rasterizeText("GUESS ROOM TEMP (\xF8" "F)");  // DEGREESYMBOL
+constexpr auto TXT_CURRENT_HUE = rasterizeText("CURRENT HUE:");
+constexpr auto TXT_FEELS_LIKE = rasterizeText("Feels like");
+constexpr auto TXT_PUSH_KNOB = rasterizeText("PUSH KNOB TO GUESS.");
+
+// static text of the selection screens, rendered once and restored each frame
+uint8_t tableLayer[Adafruit_SSD1306::BUFFER_SIZE];
+uint8_t gameModeLayer[Adafruit_SSD1306::BUFFER_SIZE];
+bool layersReady = false;
+
 int selectTable(int tableNum);
 int selectGameMode(int gameMode);
 void startGame(int tableNum, int gameMode);
 void displayInstructions(int gameMode);
 void displayAccuracy(float _accuracy);
 void lightshow();
+void drawSelectLayers();
 float guessHue(int bulbColor);
 float guessMidLine();
 float guessTemp();
@@ -74,6 +98,7 @@ void setup() {
   // Serial.printf("\n\n");
 
   display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display.setFlushMode(SSD1306_FLUSH_DIFF);  // game screens clear and redraw every pass
   display.clearDisplay();
 
   status = bme.begin(BMEADDRESS);
@@ -91,74 +116,92 @@ void setup() {
 
 // MAIN LOOP
 void loop() {
+  wemoDiscoveryLoop(); // revalidate cached wemo addresses in the background
   accuracyGauge.write(servoStartPosition);
   tableNum = selectTable(tableNum);
   gameMode = selectGameMode(gameMode);
   startGame(tableNum, gameMode);
 }
 
+// The selection screens draw their static text once and then redraw only the
+// value. display() sends the columns touched since the last frame, so clearing
+// and reprinting the whole screen on every pass would resend every lit column
+// even when the knob has not moved
 int selectTable(int tableNum) {
   myEncoder.write(tableNum * 4);
   // output values reversed? Input pullup because encoder is wired upside-down?
   digitalWrite(RED_LEDPIN, HIGH); 
   digitalWrite(GREEN_LEDPIN, HIGH); 
   digitalWrite(BLUE_LEDPIN, LOW);   
+  // static layer, then only the table number widget is redrawn when it changes
+  SSD1306Screen<Adafruit_SSD1306> screen(display);
+  SSD1306Number<Adafruit_SSD1306> table(36, 32, "Table #%i");
+  screen.add(&table);
+  drawSelectLayers();
+  display.restoreLayer(tableLayer);
+  tableNum = abs(((myEncoder.read() / 4) + 5) % 5);
+  table.set(tableNum);  // first frame already shows the current table
+  screen.begin();
+  display.display();
   while (!myButton.isClicked()) {
     tableNum = abs(((myEncoder.read() / 4) + 5) % 5); 
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(WHITE);
-    display.setCursor(11,0);
-    display.printf("TURN RIGHT KNOB TO\n");
-    display.setCursor(12,13);
-    display.printf("SELECT YOUR TABLE.\n");
-    display.setCursor(36,32);
-    display.printf("Table #%i\n", tableNum);
-    display.setCursor(5,52);
-    display.printf("PUSH BUTTON TO BEGIN.\n");
-    display.display();
+    table.set(tableNum);
+    if (screen.update()) {
+      display.display();
+    }
   }
   return tableNum;
 }
 
 int selectGameMode(int gameMode) {
   myEncoder.write(gameMode * 4);  
+  SSD1306Screen<Adafruit_SSD1306> screen(display);
+  SSD1306Label<Adafruit_SSD1306> mode(0, 32, "");
+  screen.add(&mode);
+  drawSelectLayers();
+  display.restoreLayer(gameModeLayer);
+  screen.begin();
   while (!myButton.isClicked()) {
     gameMode = abs(((myEncoder.read() / 4) + 4) % 4);
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(WHITE);
-    display.setCursor(11,0);
-    display.printf("TURN RIGHT KNOB TO\n");
-    display.setCursor(15,13);
-    display.printf("SELECT GAME MODE.\n");
-    display.setCursor(5,52);
-    display.printf("PUSH BUTTON TO BEGIN.\n");
     switch (gameMode) {
       case 0: 
-        display.setCursor(33,32);
-        display.printf("Guess Hue\n");
+        mode.set("Guess Hue", 33, 32);
         break;
       case 1: 
-        display.setCursor(23,32);
-        display.printf("Line Midpoint");
+        mode.set("Line Midpoint", 23, 32);
         break;
       case 2:
-        display.setCursor(14,32);
-        display.printf("Guess Temperature\n");
+        mode.set("Guess Temperature", 14, 32);
         break;
       case 3:
-        display.setCursor(33,32);
-        display.printf("Lightshow\n");
+        mode.set("Lightshow", 33, 32);
         break;
       default:
         break;
     }
-    display.display();
+    if (screen.update()) {
+      display.display();
+    }
   }
   return gameMode;
 }
 
+// render the fixed text of both selection screens the first time through
+void drawSelectLayers() {
+  if (layersReady) {
+    return;
+  }
+  display.clearDisplay();
+  display.blitText(11,0,TXT_TURN_KNOB);
+  display.blitText(1,52,TXT_PUSH_TO_BEGIN);  // 126 px wide, ends inside the panel
+  display.blitText(12,13,TXT_SELECT_TABLE);
+  display.saveLayer(tableLayer);
+  display.fillRect(0,13,128,8,BLACK);
+  display.blitText(15,13,TXT_SELECT_MODE);
+  display.saveLayer(gameModeLayer);
+  layersReady = true;
+}
+
 void startGame(int tableNum, int gameMode) {
   int _tableNum = tableNum;
   int _gameMode = gameMode;
@@ -217,53 +260,42 @@ void displayInstructions(int gameMode) {
   digitalWrite(RED_LEDPIN, HIGH); 
   digitalWrite(GREEN_LEDPIN, LOW); 
   digitalWrite(BLUE_LEDPIN, LOW);   
-  while (!myButton.isClicked()){
-    switch (_gameMode) {
-      case 0:   // guess hue
-        display.setCursor(14,0);
-        display.printf("REPLICATE CURRENT\n");
-        display.setCursor(14,10);
-        display.printf("HUE BULB COLOR BY\n");
-        display.setCursor(9,20);
-        display.printf("TURNING RIGHT KNOB.\n");
-        display.setCursor(0,40);
-        display.printf("PUSH BUTTON TO BEGIN.\n");
-        break;
-      case 1:   // line midpoint
-        display.setCursor(8,0);
-        display.printf("GUESS LINE MIDPOINT\n");
-        display.setCursor(14,10);
-        display.printf("USING RIGHT KNOB.\n");
-        display.setCursor(0,20);
-        display.printf("PUSH BUTTON TO BEGIN.\n");
-        display.setCursor(6,40);
-        display.printf("PUSH AGAIN TO GUESS.\n");
-        break;
-      case 2:  // guess temp
-        display.setCursor(0,0);
-        display.printf("GUESS ROOM TEMP (%cF)\n", DEGREESYMBOL);
-        display.setCursor(14,10);
-        display.printf("USING RIGHT KNOB.\n");
-        display.setCursor(0,20);
-        display.printf("PUSH BUTTON TO BEGIN.\n");
-        display.setCursor(6,40);
-        display.printf("PUSH AGAIN TO GUESS.\n");
-        break;
-      case 3:  // lightshow
-        display.setTextSize(2);
-        display.setCursor(5,0);
-        display.printf("WHOA DUDE!\n");
-        display.setTextSize(1);
-        display.setCursor(20,40);
-        display.printf("PUSH THE BUTTON\n");
-        display.setCursor(9,50);
-        display.printf("TO END THE MADNESS.\n");
-        display.display();
-        return; // skip to execution, no need to read first
-      default:
-        break;
-    }
-    display.display();
+  // nothing on these screens changes, draw once and wait for the button
+  switch (_gameMode) {
+    case 0:   // guess hue
+      display.blitText(14,0,TXT_REPLICATE_HUE);
+      display.blitText(14,10,TXT_HUE_BULB);
+      display.blitText(9,20,TXT_TURNING_KNOB);
+      display.blitText(0,40,TXT_PUSH_TO_BEGIN);
+      break;
+    case 1:   // line midpoint
+      display.blitText(8,0,TXT_GUESS_MIDPOINT);
+      display.blitText(14,10,TXT_USING_KNOB);
+      display.blitText(0,20,TXT_PUSH_TO_BEGIN);
+      display.blitText(6,40,TXT_PUSH_TO_GUESS);
+      break;
+    case 2:  // guess temp
+      display.blitText(0,0,TXT_GUESS_TEMP);
+      display.blitText(14,10,TXT_USING_KNOB);
+      display.blitText(0,20,TXT_PUSH_TO_BEGIN);
+      display.blitText(6,40,TXT_PUSH_TO_GUESS);
+      break;
+    case 3:  // lightshow
+      display.setTextSize(2);
+      display.setCursor(5,0);
+      display.printf("WHOA DUDE!\n");
+      display.setTextSize(1);
+      display.setCursor(20,40);
+      display.printf("PUSH THE BUTTON\n");
+      display.setCursor(9,50);
+      display.printf("TO END THE MADNESS.\n");
+      display.display();
+      return; // skip to execution, no need to read first
+    default:
+      break;
+  }
+  display.display();
+  while (!myButton.isClicked()) {
   }
 }
 
@@ -276,8 +308,7 @@ void displayAccuracy(float accuracy) {
   display.setCursor(36,26);
   display.printf("%0.1f%%\n", accuracy);
   display.setTextSize(1);
-  display.setCursor(14,54);
-  display.printf("PUSH BUTTON TO END\n");
+  display.blitText(14,54,TXT_PUSH_TO_END);
   display.display();
   while (!myButton.isClicked()) {
     if (accuracy > 95.0) {
@@ -399,11 +430,10 @@ float guessHue(int bulbColor) {
     }
     // display guess on OLED
     display.clearDisplay();
-    display.setCursor(34,0);
-    display.printf("CURRENT HUE:\n");
+    display.blitText(34,0,TXT_CURRENT_HUE);
     display.setCursor(50,30);
     display.printf("%i\n", _guess);
-    display.display();
+    display.displayAsync();  // sent in the background while the hue command goes out
 
     setHue((tableNum + 1), true, _guess, 255, 255);
     delay(100);
@@ -452,10 +482,15 @@ float guessMidLine() {
   digitalWrite(GREEN_LEDPIN, LOW); 
   digitalWrite(BLUE_LEDPIN, HIGH);
 
+  // the line stays put, only the marker moves (and the line is patched where it crossed)
+  SSD1306Screen<Adafruit_SSD1306> screen(display);
+  SSD1306LineWidget<Adafruit_SSD1306> line, marker;
+  screen.add(&line);
+  screen.add(&marker);
+  line.set(endpoints[0], endpoints[1], endpoints[2], endpoints[3]);
+  display.clearDisplay();
+
   while (!myButton.isClicked()) {
-    display.clearDisplay();
-    display.drawLine(endpoints[0], endpoints[1], endpoints[2], endpoints[3], WHITE);
-    display.display();
     int pos = myEncoder.read() / 4;
     if (pos < 0) {
       myEncoder.write(0);
@@ -467,19 +502,31 @@ float guessMidLine() {
     guess[0] = (float)endpoints[0] + (float)pos;
     guess[1] = (slope * pos) + yInt;
 
-    display.drawLine(guess[0], guess[1]-5, guess[0], guess[1]+5, WHITE);
-    display.display();
+    marker.set(guess[0], guess[1]-5, guess[0], guess[1]+5);
+    if (screen.update()) {
+      display.displayAsync();
+    }
   }
   accuracy = (((length / 2.0) - (abs((mid[0] + endpoints[0]) - guess[0]))) / (length / 2.0)) * 100.0;
   return accuracy;
 }
 
 float guessTemp() {
-  int currTemp = ((9.0/5.0) * bme.readTemperature()) + 32.0;
+  float celsius;
+  WITH_LOCK(Wire) {  // the display may still be flushing on the same bus
+    celsius = bme.readTemperature();
+  }
+  int currTemp = ((9.0/5.0) * celsius) + 32.0;
   int minTemp = 32;
   int maxTemp = 100;
   int tempRange = maxTemp - minTemp;
   int guess;
+  SSD1306Screen<Adafruit_SSD1306> screen(display);
+  SSD1306Number<Adafruit_SSD1306> reading(36, 26, "%i \xF8" "F", 2);  // DEGREESYMBOL
+  screen.add(&reading);
+  display.clearDisplay();
+  display.blitText(32,0,TXT_FEELS_LIKE);
+  display.blitText(9,54,TXT_PUSH_KNOB);
   while (!myButton.isClicked()) {
     guess = (myEncoder.read() / 4) + minTemp;
     if (guess < minTemp) {
@@ -490,17 +537,10 @@ float guessTemp() {
       myEncoder.write((tempRange * 4)); 
       guess = maxTemp;
     }
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setCursor(32,0);
-    display.printf("Feels like");
-    display.setTextSize(2);
-    display.setCursor(36,26);
-    display.printf("%i %cF\n", guess, DEGREESYMBOL);
-    display.setTextSize(1);
-    display.setCursor(9,54);
-    display.printf("PUSH KNOB TO GUESS.\n");
-    display.display();
+    reading.set(guess);
+    if (screen.update()) {
+      display.displayAsync();
+    }
     // calc hue between blue and red
     int tempHue = round((((guess - minTemp) * (65000.0 - 45000.0)) / (maxTemp - minTemp)) + 45000.0);
     setHue(tableNum + 1, true, tempHue, 255, 255);